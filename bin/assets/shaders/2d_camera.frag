@@ -0,0 +1,7 @@
+#version 330 core
+out vec4 FragColor;
+
+uniform vec4 v_color;
+
+void main() { FragColor = v_color; }
+
@@ -0,0 +1,41 @@
+#ifndef ARC_HPP
+#define ARC_HPP
+
+#include "Backend/DirectoryPolitics.hpp"
+
+#include <vector>
+
+struct ARCNode
+{
+    discrete_t key = 0;
+    discrete_t way = 0;
+    Link link;
+    uint8_t list = 0;
+};
+
+// Adaptive replacement cache (Megiddo and Modha, FAST 2003), run per set with
+// the associativity as the cache size c. T1/T2 hold blocks seen once/more than
+// once, B1/B2 are their ghosts, and hits on the ghosts move the T1 target `p`.
+class ARC : public DirectoryPolitics< ARCNode >
+{
+private:
+    enum List : uint8_t { T1 , T2 , B1 , B2 };
+    using ARCList = IntrusiveList< ARCNode , &ARCNode::link >;
+    struct Set
+    {
+        ARCList lists[4];
+        discrete_t p = 0;
+    };
+    std::vector< Set > sets;
+    void Move( Set &set , uint32_t node , List to );
+public:
+    ARC( discrete_t associativity , discrete_t nstes );
+    ~ARC();
+    void Miss( discrete_t index , discrete_t tag ) override;
+    discrete_t GetBlock( discrete_t index ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
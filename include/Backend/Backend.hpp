@@ -1,13 +1,17 @@
 #ifndef BACKEND_HPP
 #define BACKEND_HPP
 
+#include "common/Archive.hpp"
 #include "common/CacheAccess.hpp"
 #include "common/CacheReport.hpp"
 #include "common/CacheSpecs.hpp"
+#include "common/Options.hpp"
 #include "common/Types.hpp"
 
+#include <algorithm>
 #include <span>
 #include <string>
+#include <vector>
 
 struct Backend {
   Backend(CacheSpecs specs) : __specs(specs){};
@@ -17,8 +21,44 @@ struct Backend {
 
   virtual auto process(addr_t addr) -> CacheAccess & = 0;
   virtual auto report() -> CacheReport & = 0;
+  // Saves or restores the simulated state, for checkpoints. Overrides add
+  // their own state to this.
+  virtual auto serialize(Archive &archive) -> void {
+    archive(__cursor)(__report);
+  }
+  // Replaces the replacement policy, keeping what the cache holds.
+  virtual auto setPolicy(REPL repl, const Options &options) -> void = 0;
+  // Finishes any accesses process() accepted but has not simulated yet.
+  virtual auto drain() -> void {}
+  // Whether every access process() accepted has been simulated, i.e. report()
+  // can be read without draining.
+  virtual auto settled() -> bool { return true; }
+  // Drains, then lets the timing model time every access it was handed. Only
+  // for the end of a run or of a sample: later accesses would no longer be
+  // ordered against the ones timed early.
+  virtual auto finish() -> void { drain(); }
+  // Starts the counters of report() over, e.g. after a warm-up.
+  virtual auto resetReport() -> void { __report = CacheReport(); }
+
+  // Access type and core of every trace entry, in trace order. Frontends only
+  // hand out addresses, so process() consumes one of these per call; traces
+  // that carry neither are all reads from core 0.
+  auto setTrace(std::vector<TraceEntry> &&entries) -> void {
+    __entries = std::move(entries);
+    __cursor = 0;
+  }
+  // Passes over `count` trace entries whose accesses are not simulated.
+  auto skip(size_t count) -> void {
+    __cursor = std::min(__cursor + count, __entries.size());
+  }
 
 protected:
+  auto nextEntry() -> TraceEntry {
+    return __cursor < __entries.size() ? __entries[__cursor++] : TraceEntry();
+  }
+
+  std::vector<TraceEntry> __entries;
+  size_t __cursor = 0;
   CacheAccess __access;
   CacheReport __report;
   CacheSpecs __specs;
@@ -2,7 +2,16 @@
 #define CACHE_HPP
 
 #include "Backend/Backend.hpp"
+#include "Backend/FlatMap.hpp"
+#include "Backend/Heatmap.hpp"
+#include "Backend/Indexing.hpp"
+#include "Backend/Lifetimes.hpp"
+#include "Backend/PageMapper.hpp"
+#include "Backend/RRIP.hpp"
 #include "Backend/SubstitutionPolitics.hpp"
+#include "Backend/Timing.hpp"
+#include "Backend/WayPartition.hpp"
+#include "common/Options.hpp"
 
 #include <iostream>
 #include <random>
@@ -11,28 +20,127 @@
 #include <memory>
 #include <tuple>
 
+class TLB;
+
 // Create a concrete implementation of the Backend interface
 class Cache : public Backend {
 public:
   // TODO: can't find a way to make interface inforce this :(,
   // so don't forget it :).
-  Cache( std::span< std::string > command);
+  Cache( std::span< std::string > command , const Options &options = Options() );
   ~Cache();
 
   auto process([[maybe_unused]] addr_t addr) -> CacheAccess & override;
   auto report() -> CacheReport & override;
+  auto serialize( Archive &archive ) -> void override;
+  auto setPolicy( REPL repl , const Options &options ) -> void override;
+  auto finish() -> void override;
+  auto resetReport() -> void override;
+
+  // What process() does, with the access type given instead of read from the
+  // trace.
+  auto access( addr_t addr , AccessType type ) -> CacheAccess &;
+  // Likewise with the time and program of `entry` too, for MultiCore.
+  auto access( addr_t addr , const TraceEntry &entry ) -> CacheAccess &;
+  void SetMapper( std::shared_ptr< PageMapper > shared );
+  // Shares one DRAM between the cores, and the scheduler that orders their
+  // requests to it; only meaningful with --dram.
+  void SetMemory( std::shared_ptr< DRAM > shared , std::shared_ptr< Scheduler > clock );
+  // Snoop side of MESI, used by MultiCore. `addr` is physical. Invalidated
+  // lines keep their tag and way, the next access to them is a coherence miss.
+  Coherence State( addr_t addr );
+  void Downgrade( addr_t addr );
+  void Invalidate( addr_t addr );
+
+  // Counters of every program sharing the cache, kept with --programs.
+  struct ProgramReport
+  {
+    discrete_t accesses = 0;
+    discrete_t miss = 0;
+    // Misses on blocks another program evicted.
+    discrete_t interference = 0;
+    // Lines holding the program's blocks at the end.
+    discrete_t occupancy = 0;
+  };
+  const std::vector< ProgramReport > &Programs();
+  // Null unless --cat or --ucp was given.
+  const WayPartition *Partition();
+  // Null unless --timing was given.
+  const Timing *Latencies();
+  // Null unless --heatmap was given.
+  Heatmap *Heat();
+  // Null unless --lifetimes was given.
+  const Lifetimes *Lives();
 
 private:
   struct CacheBlock
   {
     bool val = false;
     discrete_t tag = 0;
+    // One bit per sector; unsectored caches have a single sector.
+    uint64_t sectors = 0;
+    uint64_t dirty = 0;
+    Coherence state = Coherence::INVALID;
+    uint16_t owner = 0;
+  };
+  // Who evicted a block, remembered in a direct-mapped table with a few
+  // entries per line, so old evictions get overwritten.
+  struct Eviction
+  {
+    discrete_t key = ~( discrete_t ) 0;
+    uint16_t owner = 0;
+    uint16_t evictor = 0;
   };
+  // Above this many ways blocks are found through a hash map instead of a scan.
+  static constexpr discrete_t LINEAR_LOOKUP_WAYS = 64;
   std::vector< std::vector< CacheBlock > > cache;
+  std::vector< discrete_t > setFill;
+  discrete_t filled = 0;
+  // Lines ever filled in every way, to tell when a partition is full.
+  std::vector< discrete_t > wayFill;
+  std::unique_ptr< FlatMap > blocks;
+  std::unique_ptr< Indexing > indexing;
+  std::unique_ptr< TLB > tlb;
+  std::shared_ptr< PageMapper > mapper;
+  // Last access time of every line, only used by skewed indexing.
+  std::vector< discrete_t > skewStamps;
+  discrete_t skewClock = 0;
+  bits_t sectorShift;
+  discrete_t sectorMask;
+  discrete_t sectorBytes;
   std::unique_ptr< SubstitutionPolitics >  substitutionPolitics;
+  std::unique_ptr< WayPartition > partition;
+  std::unique_ptr< Timing > timing;
+  std::unique_ptr< Heatmap > heatmap;
+  std::unique_ptr< Lifetimes > lifetimes;
+  // Accesses made to this cache, unlike the report never reset; the clock of
+  // the lifetimes.
+  discrete_t clock = 0;
+  // What the current access sent to memory, plus writebacks snoops caused
+  // since the last access. Only kept for the timing model.
+  std::vector< MemoryRequest > memory;
+  std::vector< ProgramReport > programs;
+  std::vector< Eviction > evictions;
+  bits_t evictionShift = 0;
+  uint16_t program = 0;
+  discrete_t arrival = 0;
   auto setCacheSpecs( std::span< std::string > command) -> CacheSpecs;
+  static RRIP::Insertion RRIPInsertion( REPL repl );
+  static void Partitionable( REPL repl );
+  std::unique_ptr< SubstitutionPolitics > MakePolicy( REPL repl , const Options &options );
+  CacheBlock *Find( addr_t addr );
+  uint64_t Invalid( discrete_t index );
+  void Account( AccessType type , discrete_t blockAddr , discrete_t translation , discrete_t writtenBack , discrete_t fetched );
+  void WriteBack( discrete_t blockAddr , discrete_t bytes );
+  void Evicted( const CacheBlock &victim , discrete_t key );
+  void Interference( discrete_t key );
+  void ProcessSkewed( discrete_t blockAddr , uint64_t sector , AccessType type );
+  void Fill( discrete_t index , discrete_t tag , bool isFullBlock , uint64_t sector , AccessType type );
+  void Touch( CacheBlock &line , uint64_t sector , AccessType type );
+  void Load( CacheBlock &line , discrete_t victim , discrete_t tag , uint64_t sector , AccessType type );
   bool IsFullBlock( discrete_t index );
   bool IsFull();
+  bool IsFull( uint64_t ways );
   std::tuple< bool , discrete_t > IsInTheCache( discrete_t index , discrete_t tag );
 };
 
@@ -0,0 +1,30 @@
+#ifndef COUNT_MIN_SKETCH_HPP
+#define COUNT_MIN_SKETCH_HPP
+
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Count-min sketch of 4-bit counters packed sixteen to a word, with DEPTH rows
+// of `width` counters, i.e. width * DEPTH / 2 bytes. After `sample` increments
+// every counter is halved, so old popularity fades out (TinyLFU reset).
+class CountMinSketch
+{
+private:
+    static constexpr discrete_t DEPTH = 4;
+    std::vector< uint64_t > table;
+    discrete_t widthMask;
+    discrete_t sample;
+    discrete_t additions = 0;
+    discrete_t Slot( discrete_t key , discrete_t row ) const;
+    void Reset();
+public:
+    CountMinSketch( discrete_t width , discrete_t sample );
+    ~CountMinSketch();
+    void Increment( discrete_t key );
+    uint8_t Estimate( discrete_t key ) const;
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef DIP_HPP
+#define DIP_HPP
+
+#include "Backend/SetDueling.hpp"
+#include "Backend/SubstitutionPolitics.hpp"
+
+#include <random>
+#include <vector>
+
+// Dynamic insertion policy (Qureshi et al., ISCA 2007): LRU replacement where
+// set dueling chooses between MRU insertion and bimodal insertion, which puts
+// most new blocks at the LRU position so a scan cannot flush the set.
+// Recency is kept as one access stamp per way in a flat array.
+class DIP : public SubstitutionPolitics
+{
+private:
+    std::vector< discrete_t > stamps;
+    discrete_t clock = 0;
+    discrete_t throttle;
+    SetDueling dueling;
+    std::minstd_rand gen;
+public:
+    DIP( discrete_t associativity , discrete_t nstes , discrete_t throttle , discrete_t leaders , bits_t pselBits );
+    ~DIP();
+    discrete_t GetBlock( discrete_t index ) override;
+    discrete_t GetBlockIn( discrete_t index , uint64_t ways ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
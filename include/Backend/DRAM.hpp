@@ -0,0 +1,60 @@
+#ifndef DRAM_HPP
+#define DRAM_HPP
+
+#include "common/Archive.hpp"
+#include "common/CacheReport.hpp"
+#include "common/Options.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+// A block the cache reads from or writes back to memory.
+struct MemoryRequest
+{
+    discrete_t block;
+    discrete_t bytes;
+    bool write;
+};
+
+// Open-page DRAM behind the cache. Consecutive blocks share a row, rows are
+// spread over channels, then banks, then ranks. A request to the open row of
+// its bank only pays the column access; a closed bank adds the activation and
+// another open row the precharge too. The data then waits for its channel's
+// bus, which moves --dram-bandwidth bytes per cycle.
+class DRAM
+{
+private:
+    static constexpr discrete_t CLOSED = ~( discrete_t ) 0;
+    struct Bank
+    {
+        discrete_t row = CLOSED;
+        discrete_t ready = 0;
+    };
+    discrete_t channels;
+    discrete_t ranks;
+    discrete_t banks;
+    discrete_t blocksPerRow;
+    discrete_t bytesPerCycle;
+    discrete_t cas;
+    discrete_t rcd;
+    discrete_t rp;
+    std::vector< Bank > state;
+    std::vector< discrete_t > busFree;
+    discrete_t rowHits = 0;
+    discrete_t rowMisses = 0;
+    discrete_t rowConflicts = 0;
+    discrete_t requests = 0;
+    discrete_t bytes = 0;
+    discrete_t latencies = 0;
+    discrete_t first = CLOSED;
+    discrete_t last = 0;
+public:
+    DRAM( const Options &options , discrete_t blockBytes );
+    ~DRAM();
+    // Serves a request made at cycle `time` and returns its latency.
+    discrete_t Access( const MemoryRequest &request , discrete_t time );
+    void Report( CacheReport &report ) const;
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef DIRECTORY_POLITICS_HPP
+#define DIRECTORY_POLITICS_HPP
+
+#include "Backend/FlatMap.hpp"
+#include "Backend/IntrusiveList.hpp"
+#include "Backend/SubstitutionPolitics.hpp"
+
+#include <vector>
+
+// Base for policies that remember blocks by address, including ghost entries
+// for blocks no longer in the cache. Nodes come from a pool of `perSet` entries
+// per set allocated up front, and are found through a FlatMap keyed by the
+// block address, so a simulated access never touches the heap.
+// `Node` needs `key` and `way` members.
+template < typename Node >
+class DirectoryPolitics : public SubstitutionPolitics
+{
+protected:
+    static constexpr uint32_t NONE = FlatMap::NONE;
+    discrete_t nsets;
+    std::vector< Node > nodes;
+    std::vector< uint32_t > freeNodes;
+    std::vector< uint32_t > wayNode;
+    FlatMap map;
+    // Block that missed, set by Miss and consumed by GetBlock/Insert.
+    discrete_t pendingKey = 0;
+    uint32_t pendingNode = NONE;
+
+    DirectoryPolitics( discrete_t associativity , discrete_t nstes , discrete_t perSet )
+        : SubstitutionPolitics( associativity ) , nsets( nstes ) , nodes( nstes * perSet ) ,
+          wayNode( nstes * associativity , NONE ) , map( nstes * perSet ) {
+        freeNodes.reserve( nodes.size() );
+        for ( size_t node = nodes.size() ; node > 0 ; node-- ) {
+            freeNodes.push_back( ( uint32_t ) ( node - 1 ) );
+        }
+    }
+
+    uint32_t Allocate( discrete_t key ) {
+        uint32_t node = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[node] = Node();
+        nodes[node].key = key;
+        map.Insert( key , node );
+        return node;
+    }
+
+    void Release( uint32_t node ) {
+        map.Erase( nodes[node].key );
+        freeNodes.push_back( node );
+    }
+
+    // Binds `node` to the way it now occupies.
+    void Place( discrete_t index , discrete_t block , uint32_t node ) {
+        nodes[node].way = block;
+        wayNode[index * associativity + block] = node;
+    }
+
+    uint32_t NodeAt( discrete_t index , discrete_t block ) const {
+        return wayNode[index * associativity + block];
+    }
+
+public:
+    void Miss( discrete_t index , discrete_t tag ) override {
+        pendingKey = tag * nsets + index;
+        pendingNode = map.Find( pendingKey );
+    }
+
+    void Serialize( Archive &archive ) override {
+        archive( nodes )( freeNodes )( wayNode )( map )( pendingKey )( pendingNode );
+    }
+};
+
+#endif
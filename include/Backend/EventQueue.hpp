@@ -0,0 +1,108 @@
+#ifndef EVENT_QUEUE_HPP
+#define EVENT_QUEUE_HPP
+
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <array>
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+// Discrete-event kernel. Events sit in a radix heap: bucket b holds the events
+// whose time first differs from the last popped time at bit b - 1, so popping
+// only rescans a bucket when the one below it runs dry, and every event moves
+// down at most 64 times. Buckets are FIFO lists, which keeps events scheduled
+// for the same cycle in the order they were scheduled. Events live in a pool
+// addressed by index and are recycled through a free list, so scheduling does
+// not allocate once the pool has grown to the peak number of pending events.
+//
+// Times only go forward: scheduling before Now() schedules at Now().
+//
+// Components that are checkpointed register their actions once and schedule
+// them by handler id. A queue holding only such events saves as plain data and
+// is restored into a queue with the same handlers registered in the same order.
+class EventQueue
+{
+public:
+    using Action = void ( * )( void *context );
+
+    // Awaited by a Process to sleep until `time`. It always yields, so other
+    // events due at the same cycle run first.
+    struct Wake
+    {
+        EventQueue &queue;
+        discrete_t time;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend( std::coroutine_handle<> handle ) { queue.Schedule( time , handle ); }
+        void await_resume() const noexcept {}
+    };
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr size_t BUCKETS = 65;
+    struct Event
+    {
+        discrete_t time = 0;
+        uint32_t next = NIL;
+        uint32_t handler = NIL;
+        Action action = nullptr;
+        void *context = nullptr;
+    };
+    struct Handler
+    {
+        Action action;
+        void *context;
+    };
+    struct Bucket
+    {
+        uint32_t head = NIL;
+        uint32_t tail = NIL;
+    };
+    std::vector< Event > events;
+    std::vector< Handler > handlers;
+    std::array< Bucket , BUCKETS > buckets;
+    uint32_t freeList = NIL;
+    discrete_t now = 0;
+    discrete_t pending = 0;
+    discrete_t processed = 0;
+    size_t BucketOf( discrete_t time ) const;
+    void Append( size_t bucket , uint32_t event );
+    uint32_t Insert( discrete_t time , Action action , void *context );
+    bool Advance( discrete_t until );
+public:
+    EventQueue();
+    ~EventQueue();
+    discrete_t Now() const;
+    bool Empty() const;
+    // Events run so far.
+    discrete_t Processed() const;
+    void Schedule( discrete_t time , Action action , void *context );
+    void Schedule( discrete_t time , std::coroutine_handle<> handle );
+    uint32_t Register( Action action , void *context );
+    void Schedule( discrete_t time , uint32_t handler );
+    // Runs the earliest event if it is due by `until`, and tells whether it did.
+    bool RunNext( discrete_t until = ~( discrete_t ) 0 );
+    // Runs events in time order until none is left or the next one is due
+    // after `until`, and returns the time reached.
+    discrete_t Run( discrete_t until = ~( discrete_t ) 0 );
+    Wake At( discrete_t time );
+    Wake Delay( discrete_t cycles );
+    void Serialize( Archive &archive );
+};
+
+// A coroutine run by an EventQueue, e.g.
+//     auto Ping( EventQueue &queue ) -> Process { co_await queue.Delay( 10 ); ... }
+// It starts as soon as it is called and frees itself when it returns.
+struct Process
+{
+    struct promise_type
+    {
+        Process get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+#endif
@@ -15,6 +15,7 @@ public:
     ~FIFO();
     discrete_t GetBlock( discrete_t index ) override;
     void Refresh(discrete_t index, discrete_t block) override;
+    void Serialize(Archive &archive) override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Open-addressing map from block keys to node indices, sized once for the
+// maximum number of entries so lookups and updates never allocate. Uses
+// linear probing with backward-shift deletion, so there are no tombstones.
+class FlatMap
+{
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+private:
+    static constexpr discrete_t EMPTY = ~( discrete_t ) 0;
+    struct Slot
+    {
+        discrete_t key = EMPTY;
+        uint32_t value = NONE;
+    };
+    std::vector< Slot > slots;
+    discrete_t mask;
+    bits_t shift;
+    discrete_t Home( discrete_t key ) const;
+public:
+    FlatMap( discrete_t capacity );
+    ~FlatMap();
+    uint32_t Find( discrete_t key ) const;
+    void Insert( discrete_t key , uint32_t value );
+    void Erase( discrete_t key );
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef HEATMAP_HPP
+#define HEATMAP_HPP
+
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Where accesses and misses land: counters per set in a flat array, and per
+// address region of 2^regionBits bytes, only for the regions touched.
+// Evictions are only counted per set.
+class Heatmap
+{
+public:
+    struct Counters
+    {
+        discrete_t accesses = 0;
+        discrete_t hits = 0;
+        discrete_t compulsory = 0;
+        discrete_t capacity = 0;
+        discrete_t conflict = 0;
+        discrete_t sector = 0;
+        discrete_t coherence = 0;
+        discrete_t evictions = 0;
+        void Add( AccessResult result );
+        void Merge( const Counters &other );
+    };
+private:
+    std::vector< Counters > sets;
+    std::unordered_map< discrete_t , Counters > regions;
+    bits_t regionBits;
+public:
+    Heatmap( discrete_t nsets , bits_t regionBits );
+    ~Heatmap();
+    void Access( discrete_t set , addr_t addr , AccessResult result );
+    void Evicted( discrete_t set );
+    void Merge( const Heatmap &other );
+    void Clear();
+    const std::vector< Counters > &Sets() const;
+    // Touched regions by start address, in address order.
+    std::vector< std::pair< discrete_t , Counters > > Regions() const;
+    void Serialize( Archive &archive );
+};
+
+#endif
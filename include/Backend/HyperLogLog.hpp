@@ -0,0 +1,24 @@
+#ifndef HYPER_LOG_LOG_HPP
+#define HYPER_LOG_LOG_HPP
+
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Estimates how many distinct keys were added with 2^precision one-byte
+// registers, within about 1.04 / sqrt(2^precision). Small counts fall back to
+// linear counting over the empty registers.
+class HyperLogLog
+{
+private:
+    std::vector< uint8_t > registers;
+    bits_t precision;
+public:
+    HyperLogLog( bits_t precision );
+    ~HyperLogLog();
+    void Add( discrete_t key );
+    discrete_t Estimate() const;
+    void Clear();
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef INDEXING_HPP
+#define INDEXING_HPP
+
+#include "common/Types.hpp"
+
+// Maps a block address (the address without its offset) to the set it lives in
+// and the tag stored for it. Index and tag together must identify the block.
+class Indexing
+{
+protected:
+    discrete_t nsets;
+public:
+    Indexing( discrete_t nsets ) : nsets( nsets ) {}
+    virtual ~Indexing() = default;
+    // Set used by `way`; only skewed functions depend on the way.
+    virtual discrete_t Index( discrete_t block , discrete_t way ) const = 0;
+    virtual discrete_t Tag( discrete_t block ) const = 0;
+    // The block address a set and tag stand for, the inverse of the above.
+    virtual discrete_t Block( discrete_t index , discrete_t tag ) const = 0;
+    // Whether every way has its own index function.
+    virtual bool Skewed() const { return false; }
+};
+
+#endif
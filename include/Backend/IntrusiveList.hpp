@@ -0,0 +1,66 @@
+#ifndef INTRUSIVE_LIST_HPP
+#define INTRUSIVE_LIST_HPP
+
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Links of a node stored in a pool, addressed by index instead of pointer so the
+// pool can be a flat vector allocated once.
+struct Link
+{
+    static constexpr uint32_t NIL = UINT32_MAX;
+    uint32_t prev = NIL;
+    uint32_t next = NIL;
+};
+
+// Doubly linked list threaded through the `L` member of pooled nodes. The front
+// is the most recently inserted node and the back the oldest.
+template < typename Node , Link Node::*L >
+struct IntrusiveList
+{
+    uint32_t head = Link::NIL;
+    uint32_t tail = Link::NIL;
+    discrete_t size = 0;
+
+    bool Empty() const { return size == 0; }
+    uint32_t Back() const { return tail; }
+
+    void PushFront( std::vector< Node > &nodes , uint32_t node ) {
+        Link &link = nodes[node].*L;
+        link.prev = Link::NIL;
+        link.next = head;
+        if ( head != Link::NIL ) {
+            ( nodes[head].*L ).prev = node;
+        } else {
+            tail = node;
+        }
+        head = node;
+        size++;
+    }
+
+    void Remove( std::vector< Node > &nodes , uint32_t node ) {
+        Link &link = nodes[node].*L;
+        if ( link.prev != Link::NIL ) {
+            ( nodes[link.prev].*L ).next = link.next;
+        } else {
+            head = link.next;
+        }
+        if ( link.next != Link::NIL ) {
+            ( nodes[link.next].*L ).prev = link.prev;
+        } else {
+            tail = link.prev;
+        }
+        link = Link();
+        size--;
+    }
+
+    void MoveToFront( std::vector< Node > &nodes , uint32_t node ) {
+        if ( head != node ) {
+            Remove( nodes , node );
+            PushFront( nodes , node );
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef LFU_HPP
+#define LFU_HPP
+
+#include "Backend/SubstitutionPolitics.hpp"
+
+#include <vector>
+
+// Least frequently used with a saturating 8-bit counter per way. Every `aging`
+// accesses to a set its counters are halved, so blocks that were hot long ago
+// can still be evicted.
+class LFU : public SubstitutionPolitics
+{
+private:
+    std::vector< uint8_t > counts;
+    std::vector< discrete_t > accesses;
+    discrete_t aging;
+    void Access( discrete_t index );
+public:
+    LFU( discrete_t associativity , discrete_t nstes , discrete_t aging );
+    ~LFU();
+    discrete_t GetBlock( discrete_t index ) override;
+    discrete_t GetBlockIn( discrete_t index , uint64_t ways ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef LIRS_HPP
+#define LIRS_HPP
+
+#include "Backend/DirectoryPolitics.hpp"
+
+#include <vector>
+
+struct LIRSNode
+{
+    discrete_t key = 0;
+    discrete_t way = 0;
+    Link stack;
+    // Resident HIR blocks are linked in the queue, non-resident ones in the
+    // ghost FIFO; a node is never in both.
+    Link queue;
+    uint8_t state = 0;
+    bool inStack = false;
+};
+
+// Low inter-reference recency set (Jiang and Zhang, SIGMETRICS 2002), run per
+// set. Blocks with a short reuse distance are LIR and always resident; the few
+// HIR slots take everything else, so one-time blocks only ever churn those.
+// Non-resident HIR entries are capped at the associativity per set.
+class LIRS : public DirectoryPolitics< LIRSNode >
+{
+private:
+    enum State : uint8_t { LIR , HIR , NONRESIDENT };
+    using StackList = IntrusiveList< LIRSNode , &LIRSNode::stack >;
+    using QueueList = IntrusiveList< LIRSNode , &LIRSNode::queue >;
+    struct Set
+    {
+        StackList stack;
+        QueueList queue;
+        QueueList ghosts;
+        discrete_t lir = 0;
+    };
+    std::vector< Set > sets;
+    discrete_t lirLimit;
+    void Prune( Set &set );
+    void Demote( Set &set );
+public:
+    LIRS( discrete_t associativity , discrete_t nstes , discrete_t hirPercent );
+    ~LIRS();
+    discrete_t GetBlock( discrete_t index ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
@@ -14,7 +14,9 @@ public:
     LRU( discrete_t associativity , discrete_t nstes ); 
     ~LRU();
     discrete_t GetBlock( discrete_t index ) override;
+    discrete_t GetBlockIn( discrete_t index , uint64_t ways ) override;
     void Refresh(discrete_t index, discrete_t block) override;
+    void Serialize(Archive &archive) override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef LIFETIMES_HPP
+#define LIFETIMES_HPP
+
+#include "common/Archive.hpp"
+#include "common/CacheReport.hpp"
+#include "common/Types.hpp"
+
+#include <array>
+#include <vector>
+
+// Generations of the blocks the cache evicts. Each line remembers when its
+// block was filled, last used and how often it hit; on eviction that becomes
+// the block's live time (fill to last use), dead time (last use to eviction)
+// and hit count, added to power-of-two histograms. Times count the accesses
+// to the cache, and blocks still cached at the end are left out.
+class Lifetimes
+{
+public:
+    static constexpr discrete_t BUCKETS = 40;
+    // Bucket 0 counts zeros and bucket b values in [2^(b-1), 2^b).
+    using Histogram = std::array< discrete_t , BUCKETS >;
+    static discrete_t From( discrete_t bucket );
+private:
+    struct Line
+    {
+        discrete_t filled = 0;
+        discrete_t used = 0;
+        discrete_t hits = 0;
+    };
+    std::vector< Line > lines;
+    Histogram live = {};
+    Histogram dead = {};
+    Histogram hits = {};
+    discrete_t evicted = 0;
+    discrete_t neverHit = 0;
+    discrete_t liveTime = 0;
+    discrete_t deadTime = 0;
+    static void Add( Histogram &histogram , discrete_t value );
+public:
+    Lifetimes( discrete_t lines );
+    ~Lifetimes();
+    void Fill( discrete_t line , discrete_t now );
+    void Use( discrete_t line , discrete_t now , bool hit );
+    void Evict( discrete_t line , discrete_t now );
+    void Merge( const Lifetimes &other );
+    // Forgets what was evicted so far, lines keep their stamps.
+    void Clear();
+    void Report( CacheReport &report ) const;
+    const Histogram &Live() const;
+    const Histogram &Dead() const;
+    const Histogram &Hits() const;
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MODULO_INDEXING_HPP
+#define MODULO_INDEXING_HPP
+
+#include "Backend/Indexing.hpp"
+
+// Conventional indexing, block % nsets with tag block / nsets. Power-of-two set
+// counts use a shift and a mask; any other count uses Lemire's fastmod, a
+// multiplication by a precomputed 64-bit reciprocal instead of a division.
+class ModuloIndexing : public Indexing
+{
+private:
+    bool pow2;
+    bits_t shift;
+    uint64_t reciprocal;
+public:
+    ModuloIndexing( discrete_t nsets );
+    ~ModuloIndexing();
+    discrete_t Index( discrete_t block , [[maybe_unused]] discrete_t way ) const override;
+    discrete_t Tag( discrete_t block ) const override;
+    discrete_t Block( discrete_t index , discrete_t tag ) const override;
+};
+
+#endif
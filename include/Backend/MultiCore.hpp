@@ -0,0 +1,90 @@
+#ifndef MULTI_CORE_HPP
+#define MULTI_CORE_HPP
+
+#include "Backend/Backend.hpp"
+#include "Backend/Cache.hpp"
+#include "Backend/PageMapper.hpp"
+#include "Backend/SharingProfiler.hpp"
+#include "common/Options.hpp"
+
+#include <barrier>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Private caches of several cores kept coherent by a snooping MESI protocol:
+// read misses, write misses and writes to shared lines are broadcast to every
+// other cache, as on a bus. Trace entries name their core; ids past the last
+// core wrap around. The cores share one address space, so one page mapping.
+//
+// With several host threads the trace is cut into quanta. Inside a quantum
+// every thread runs its cores' accesses on their private caches without
+// locks and only records the bus transactions; at the boundary those are
+// replayed in trace order, so the result does not depend on the scheduling.
+class MultiCore : public Backend {
+public:
+  MultiCore( std::span< std::string > command , const Options &options );
+  ~MultiCore();
+
+  auto process([[maybe_unused]] addr_t addr) -> CacheAccess & override;
+  auto report() -> CacheReport & override;
+  auto serialize( Archive &archive ) -> void override;
+  auto setPolicy( REPL repl , const Options &options ) -> void override;
+  auto drain() -> void override;
+  auto settled() -> bool override;
+  auto finish() -> void override;
+  auto resetReport() -> void override;
+
+  discrete_t Cores();
+  CacheReport &CoreReport( discrete_t core );
+  Cache &Core( discrete_t core );
+  // Null unless --sharing was given.
+  SharingProfiler *Profiler();
+
+private:
+  // Bus transactions a core started.
+  struct Traffic
+  {
+    discrete_t invalidations = 0;
+    discrete_t upgrades = 0;
+    discrete_t interventions = 0;
+  };
+  struct Pending
+  {
+    addr_t addr;
+    addr_t phys;
+    discrete_t seq;
+    TraceEntry entry;
+  };
+  // What access `seq` of a quantum did, replayed at the boundary.
+  struct Step
+  {
+    bool bus = false;
+    bool coherenceMiss = false;
+    AccessType type = AccessType::READ;
+    Coherence state = Coherence::INVALID;
+    uint16_t core = 0;
+    addr_t phys = 0;
+  };
+  std::vector< std::unique_ptr< Cache > > cores;
+  std::vector< Traffic > traffic;
+  std::shared_ptr< PageMapper > mapper;
+  std::shared_ptr< DRAM > dram;
+  std::shared_ptr< Scheduler > scheduler;
+  std::unique_ptr< SharingProfiler > profiler;
+  discrete_t quantum = 0;
+  discrete_t buffered = 0;
+  std::vector< std::vector< Pending > > pending;
+  std::vector< Step > steps;
+  std::vector< std::thread > workers;
+  std::unique_ptr< std::barrier<> > start;
+  std::unique_ptr< std::barrier<> > done;
+  bool stopping = false;
+  static bool NeedsBus( AccessType type , Coherence state );
+  bool Snoop( discrete_t core , addr_t phys , AccessType type , Coherence state );
+  void RunQuantum();
+  void Work( discrete_t worker );
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef NRU_HPP
+#define NRU_HPP
+
+#include "Backend/SubstitutionPolitics.hpp"
+
+#include <vector>
+
+// Not-recently-used: one reference bit per way, packed in a word per set. The
+// victim is the first way whose bit is clear; once every bit is set they are all
+// cleared except the one just used. Supports up to 64 ways.
+class NRU : public SubstitutionPolitics
+{
+private:
+    std::vector< uint64_t > used;
+    uint64_t full;
+    void Touch( discrete_t index , discrete_t block );
+public:
+    NRU( discrete_t associativity , discrete_t nstes );
+    ~NRU();
+    discrete_t GetBlock( discrete_t index ) override;
+    discrete_t GetBlockIn( discrete_t index , uint64_t ways ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef PLRU_HPP
+#define PLRU_HPP
+
+#include "Backend/SubstitutionPolitics.hpp"
+
+#include <vector>
+
+// Tree pseudo-LRU: the assoc - 1 nodes of a binary tree live in one word per
+// set, node n at bit n - 1, and each node points to the half holding the victim.
+// Needs a power-of-two associativity of at most 64 ways.
+class PLRU : public SubstitutionPolitics
+{
+private:
+    std::vector< uint64_t > trees;
+    void Touch( discrete_t index , discrete_t block );
+public:
+    PLRU( discrete_t associativity , discrete_t nstes );
+    ~PLRU();
+    discrete_t GetBlock( discrete_t index ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PAGE_MAPPER_HPP
+#define PAGE_MAPPER_HPP
+
+#include "common/Archive.hpp"
+#include "common/Options.hpp"
+#include "common/Types.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+// Virtual to physical translation applied before the cache is indexed. Frames
+// are handed out on first touch by one of the allocators below and remembered
+// in a two-level radix page table whose leaves are only created for touched
+// regions, so a lookup is two array reads.
+class PageMapper
+{
+public:
+    enum class Allocator { IDENTITY , RANDOM , COLOR , HUGE };
+private:
+    static constexpr bits_t LEAF_BITS = 10;
+    static constexpr bits_t HUGE_PAGE_BITS = 21;
+    Allocator allocator;
+    bits_t pageBits;
+    discrete_t frames;
+    // Frame + 1 for every mapped page, 0 when unmapped.
+    std::vector< std::vector< uint32_t > > table;
+    // RANDOM: frames[0, nextFree) are taken, the rest is still shuffled.
+    std::vector< uint32_t > freeFrames;
+    discrete_t nextFree = 0;
+    // COLOR: next frame of every color.
+    std::vector< discrete_t > nextOfColor;
+    std::mt19937_64 gen;
+    uint32_t Allocate( discrete_t page );
+public:
+    PageMapper( Allocator allocator , const Options &options , discrete_t cacheBytes , discrete_t assoc );
+    ~PageMapper();
+    // The allocator named by `--mapping`, identity when the name is unknown.
+    static Allocator Kind( const std::string &name );
+    addr_t Translate( addr_t addr );
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -3,16 +3,22 @@
 
 #include "Backend/SubstitutionPolitics.hpp"
 
+#include <random>
 #include <stdlib.h> 
 #include <time.h>
 
 class RANDOM : public SubstitutionPolitics
 {
+private:
+    // One generator per cache, so cores on different threads do not share it.
+    std::mt19937 gen;
 public:
-    RANDOM( discrete_t associativity , [[maybe_unused]] discrete_t nstes ); 
+    RANDOM( discrete_t associativity , [[maybe_unused]] discrete_t nstes , discrete_t seed ); 
     ~RANDOM();
     discrete_t GetBlock( [[maybe_unused]] discrete_t index ) override;
+    discrete_t GetBlockIn( discrete_t index , uint64_t ways ) override;
     void Refresh( [[maybe_unused]] discrete_t index, [[maybe_unused]] discrete_t block) override;
+    void Serialize( Archive &archive ) override;
 };
 
 #endif
\ No newline at end of file
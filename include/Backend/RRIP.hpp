@@ -0,0 +1,37 @@
+#ifndef RRIP_HPP
+#define RRIP_HPP
+
+#include "Backend/SetDueling.hpp"
+#include "Backend/SubstitutionPolitics.hpp"
+
+#include <random>
+#include <vector>
+
+// Re-reference interval prediction (Jaleel et al., ISCA 2010). Every way keeps
+// an RRPV of `rrpvBits`; hits promote to 0, the victim is the first way at the
+// distant value, and the policies only differ in where a new block is inserted:
+// SRRIP at long (max - 1), BRRIP mostly at distant and DRRIP duels the two.
+class RRIP : public SubstitutionPolitics
+{
+public:
+    enum class Insertion { STATIC , BIMODAL , DYNAMIC };
+protected:
+    Insertion insertion;
+    uint8_t rrpvMax;
+    discrete_t throttle;
+    std::vector< uint8_t > rrpv;
+    SetDueling dueling;
+    std::minstd_rand gen;
+    bool Bimodal();
+public:
+    RRIP( discrete_t associativity , discrete_t nstes , Insertion insertion , bits_t rrpvBits ,
+          discrete_t throttle , discrete_t leaders , bits_t pselBits );
+    ~RRIP();
+    discrete_t GetBlock( discrete_t index ) override;
+    discrete_t GetBlockIn( discrete_t index , uint64_t ways ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
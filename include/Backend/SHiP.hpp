@@ -0,0 +1,45 @@
+#ifndef SHIP_HPP
+#define SHIP_HPP
+
+#include "Backend/RRIP.hpp"
+
+#include <vector>
+
+// Signature-based hit predictor (Wu et al., MICRO 2011) on top of SRRIP. Traces
+// have no PC, so the signature is a hash of the address region a block belongs
+// to. A table of 3-bit counters learns, per signature, whether inserted blocks
+// get hit before eviction; blocks from signatures at 0 are predicted dead and
+// inserted at distant RRPV, or bypassed when `bypass` is set.
+class SHiP : public RRIP
+{
+private:
+    struct Line
+    {
+        uint16_t signature = 0;
+        bool valid = false;
+        bool reused = false;
+        bool dead = false;
+    };
+    static constexpr uint8_t COUNTER_MAX = 7;
+    std::vector< Line > lines;
+    std::vector< uint8_t > shct;
+    discrete_t nsets;
+    bits_t regionShift;
+    bool bypass;
+    discrete_t deadMisses = 0;
+    uint16_t pending = 0;
+    discrete_t predictions = 0;
+    discrete_t correct = 0;
+public:
+    SHiP( discrete_t associativity , discrete_t nstes , bits_t rrpvBits , bits_t regionShift ,
+          bits_t shctBits , bool bypass );
+    ~SHiP();
+    void Miss( discrete_t index , discrete_t tag ) override;
+    bool Bypass( discrete_t index ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+    void Report( CacheReport &report ) override;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "Backend/EventQueue.hpp"
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+class Timing;
+
+// Runs the timing models of the caches that share a memory as processes on one
+// event queue, so their requests reach memory in the order they are made
+// rather than in trace order. The functional caches hand accesses over in
+// trace order, and the queue only runs up to the earliest cycle an access
+// still to come could issue at: not before its core is free again, nor before
+// the latest trace time, traces being in time order. A core more than
+// LOOKAHEAD accesses ahead of that stops waiting for the others.
+class Scheduler
+{
+private:
+    static constexpr size_t LOOKAHEAD = 4096;
+    EventQueue events;
+    std::vector< Timing * > members;
+    // Set when a member runs out of accesses, which may pull the horizon back.
+    bool drained = false;
+    discrete_t Horizon( discrete_t arrival ) const;
+public:
+    Scheduler();
+    ~Scheduler();
+    EventQueue &Events();
+    void Join( Timing *timing );
+    void Drained();
+    // Runs what the access `timing` was just handed, made at trace time
+    // `arrival`, lets run.
+    void Advance( Timing *timing , discrete_t arrival );
+    // Runs every event left, e.g. once the trace has ended.
+    void Finish();
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef SET_DUELING_HPP
+#define SET_DUELING_HPP
+
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Picks between two insertion policies: a few leader sets always use policy A
+// or policy B, and a saturating PSEL counter trained on their misses decides
+// what every follower set uses.
+class SetDueling
+{
+public:
+    enum class Role : uint8_t { FOLLOWER , LEADER_A , LEADER_B };
+private:
+    std::vector< Role > roles;
+    discrete_t psel;
+    discrete_t pselMax;
+public:
+    SetDueling( discrete_t nsets , discrete_t leaders , bits_t pselBits );
+    ~SetDueling();
+    Role GetRole( discrete_t index ) const { return roles[index]; }
+    void Miss( discrete_t index );
+    bool UseB( discrete_t index ) const;
+    void Serialize( Archive &archive );
+};
+
+#endif
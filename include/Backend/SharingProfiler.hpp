@@ -0,0 +1,63 @@
+#ifndef SHARING_PROFILER_HPP
+#define SHARING_PROFILER_HPP
+
+#include "common/Archive.hpp"
+#include "common/Types.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+// Classifies coherence misses as true or false sharing, following Dubois et
+// al.: a miss is true sharing if, while the new copy lives, its core touches a
+// byte that another core wrote after invalidating the old one. Blocks are
+// tracked as 64-bit byte masks (one bit per block / 64 bytes when larger), and
+// only for lines that have been invalidated at least once.
+class SharingProfiler
+{
+public:
+    struct Hotspot
+    {
+        discrete_t addr = 0;
+        discrete_t invalidations = 0;
+        discrete_t trueSharing = 0;
+        discrete_t falseSharing = 0;
+        // Cores that wrote or lost the line, modulo 64.
+        uint64_t cores = 0;
+    };
+private:
+    // A core's view of a line since it was last invalidated.
+    struct Copy
+    {
+        uint16_t core;
+        // Fetched again by a coherence miss, as opposed to still invalid.
+        bool live = false;
+        bool trueSharing = false;
+        uint64_t written = 0;
+    };
+    struct Line
+    {
+        Hotspot hotspot;
+        std::vector< Copy > copies;
+        void Serialize( Archive &archive ) { archive( hotspot )( copies ); }
+    };
+    std::unordered_map< discrete_t , Line > lines;
+    bits_t offsetBits;
+    bits_t granuleBits;
+    discrete_t accessSize;
+    discrete_t trueSharing = 0;
+    discrete_t falseSharing = 0;
+    uint64_t Bytes( addr_t addr ) const;
+public:
+    SharingProfiler( bits_t offsetBits , discrete_t accessSize );
+    ~SharingProfiler();
+    void Invalidate( addr_t addr , discrete_t core );
+    void Access( addr_t addr , discrete_t core , AccessType type , bool coherenceMiss );
+    discrete_t TrueSharing() const;
+    discrete_t FalseSharing() const;
+    // The `top` lines with the most invalidations, merged into regions of
+    // 2^regionBits bytes when that is larger than a block.
+    std::vector< Hotspot > Ranked( discrete_t top , bits_t regionBits ) const;
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef SIM_POINT_HPP
+#define SIM_POINT_HPP
+
+#include "common/Types.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+// Phases of a trace, SimPoint style. Every interval of `length` accesses
+// becomes the share of its accesses going to each region, randomly projected
+// to `dims` dimensions so the vectors do not grow with the footprint. k-means
+// groups intervals that behave alike.
+class SimPoint
+{
+public:
+    struct Phase
+    {
+        // Intervals in the cluster, ascending; the representative is the one
+        // closest to the centroid.
+        std::vector< discrete_t > members;
+        discrete_t representative = 0;
+        discrete_t accesses = 0;
+    };
+private:
+    discrete_t length;
+    bits_t region;
+    discrete_t dims;
+    std::unordered_map< discrete_t , discrete_t > regions;
+    discrete_t current = 0;
+    std::vector< std::vector< double > > features;
+    std::vector< discrete_t > sizes;
+    double Projection( discrete_t region , discrete_t dim ) const;
+    static double Distance( const std::vector< double > &a , const std::vector< double > &b );
+public:
+    SimPoint( discrete_t length , bits_t region , discrete_t dims );
+    ~SimPoint();
+    void Access( addr_t addr );
+    // Closes the last interval, however short.
+    void Finish();
+    discrete_t Intervals() const;
+    discrete_t Length() const;
+    // Accesses in `interval`, `length` for all but the last.
+    discrete_t Size( discrete_t interval ) const;
+    // Up to `k` phases, empty clusters dropped; k-means++ seeded by `seed`.
+    std::vector< Phase > Cluster( discrete_t k , discrete_t seed ) const;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SKEWED_INDEXING_HPP
+#define SKEWED_INDEXING_HPP
+
+#include "Backend/Indexing.hpp"
+
+#include <vector>
+
+// Skewed-associative indexing (Seznec, ISCA 1993), as used by zcache: each way
+// hashes the block with its own multiplier, so blocks that conflict in one way
+// are spread apart in the others. The whole block address is the tag.
+class SkewedIndexing : public Indexing
+{
+private:
+    std::vector< uint64_t > seeds;
+public:
+    SkewedIndexing( discrete_t nsets , discrete_t assoc );
+    ~SkewedIndexing();
+    discrete_t Index( discrete_t block , discrete_t way ) const override;
+    discrete_t Tag( discrete_t block ) const override;
+    discrete_t Block( discrete_t index , discrete_t tag ) const override;
+    bool Skewed() const override { return true; }
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SPACE_SAVING_HPP
+#define SPACE_SAVING_HPP
+
+#include "Backend/FlatMap.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Space-Saving heavy hitters over `capacity` counters. An unmonitored key
+// takes over the smallest counter and inherits its count as error, so any key
+// seen more than total / capacity times is monitored and counts never
+// undershoot. Counters are kept sorted by count, with the last position of
+// every count looked up by hash, so an update is a swap and never a search.
+class SpaceSaving
+{
+public:
+    struct Counter
+    {
+        discrete_t key;
+        discrete_t count;
+        // Upper bound of the overestimate.
+        discrete_t error;
+    };
+private:
+    // Ascending; counters nobody took yet hold 0.
+    std::vector< Counter > counters;
+    // Key to position, and count to the last position holding it.
+    FlatMap slots;
+    FlatMap last;
+    void Increment( uint32_t slot );
+public:
+    SpaceSaving( discrete_t capacity );
+    ~SpaceSaving();
+    void Add( discrete_t key );
+    // The `count` largest counters, largest first.
+    std::vector< Counter > Top( discrete_t count ) const;
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef SUBSTITUTION_POLITICS_HPP
 #define SUBSTITUTION_POLITICS_HPP
 
+#include "common/Archive.hpp"
+#include "common/CacheReport.hpp"
 #include "common/CacheSpecs.hpp"
 
 class SubstitutionPolitics
@@ -14,6 +16,22 @@ protected:
     virtual ~SubstitutionPolitics() = default;
     virtual discrete_t GetBlock( discrete_t index ) = 0;
     virtual void Refresh( discrete_t index , discrete_t block ) = 0;
+    // GetBlock restricted to the ways set in `ways`, for way partitioning.
+    // Policies that cannot restrict their choice ignore `ways`; the cache only
+    // partitions the ones that override this.
+    virtual discrete_t GetBlockIn( discrete_t index , [[maybe_unused]] uint64_t ways ) { return GetBlock( index ); }
+    // Called on every miss before GetBlock, for policies that track blocks by
+    // address rather than by way.
+    virtual void Miss( [[maybe_unused]] discrete_t index , [[maybe_unused]] discrete_t tag ) {}
+    // Called after a miss has been placed in `block`, which may be an invalid
+    // way rather than the one returned by GetBlock.
+    virtual void Insert( [[maybe_unused]] discrete_t index , [[maybe_unused]] discrete_t block ) {}
+    // Asked after Miss; returning true leaves the missing block out of the cache.
+    virtual bool Bypass( [[maybe_unused]] discrete_t index ) { return false; }
+    // Adds policy specific counters to the report.
+    virtual void Report( [[maybe_unused]] CacheReport &report ) {}
+    // Saves or restores the policy's state, for checkpoints.
+    virtual void Serialize( Archive &archive ) = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,38 @@
+#ifndef TLB_HPP
+#define TLB_HPP
+
+#include "Backend/Cache.hpp"
+#include "common/Archive.hpp"
+#include "common/CacheReport.hpp"
+#include "common/Options.hpp"
+
+#include <memory>
+
+// Two-level TLB in front of the data cache. Each level is a Cache whose blocks
+// are pages, so its tags are virtual page numbers; an L2 miss is a page walk
+// costing `walkLatency` cycles for every level of a radix page table with
+// 512-entry (9-bit) levels.
+class TLB
+{
+private:
+    std::unique_ptr< Cache > l1;
+    std::unique_ptr< Cache > l2;
+    discrete_t l2Latency;
+    discrete_t walkLatency;
+    discrete_t walkLevels;
+    discrete_t walks = 0;
+    static std::unique_ptr< Cache > MakeLevel( discrete_t nsets , discrete_t pageSize , discrete_t assoc , const std::string &repl ,
+                                               const Options &options );
+public:
+    TLB( const Options &options );
+    ~TLB();
+    // The --page-size option, halting unless it is a power of two of at least 1 KiB.
+    static discrete_t PageSize( const Options &options );
+    // Cycles the translation adds: none on an L1 hit, the L2 latency on an
+    // L1 miss and the walk on top of it on an L2 miss.
+    discrete_t Translate( addr_t addr );
+    void Report( CacheReport &report );
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef TIMING_HPP
+#define TIMING_HPP
+
+#include "Backend/DRAM.hpp"
+#include "Backend/Scheduler.hpp"
+#include "common/Archive.hpp"
+#include "common/CacheReport.hpp"
+#include "common/Options.hpp"
+#include "common/Types.hpp"
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Latency of every access: the cache's hit latency, plus the memory latency
+// on any miss and the writeback latency when a dirty block leaves, plus what
+// the TLB added. Latencies are kept in power-of-two histograms per access type.
+//
+// A blocking cache serves one access at a time, so the run takes the sum of
+// the latencies. With --mshrs the cache is non-blocking: accesses issue in
+// order at their trace time or every --issue-interval cycles, wait for their
+// bank, and misses hold an MSHR until memory answers. Accesses to a block
+// whose fill is in flight merge into its MSHR, and a miss finding every MSHR
+// busy stalls the issue until one frees up.
+//
+// With a DRAM model the memory latency is whatever the DRAM takes to return
+// the block, and writebacks are posted: they keep banks and bus busy but no
+// access waits for them.
+//
+// The model is a process on its Scheduler's event queue. Accesses wait in an
+// inbox; the oldest one wakes up when it issues and when its bank is free, and
+// a miss finding every MSHR busy sleeps until the next fill completes. Only
+// then does it send its requests to memory.
+class Timing
+{
+public:
+    static constexpr discrete_t BUCKETS = 24;
+    using Histogram = std::array< discrete_t , BUCKETS >;
+private:
+    struct Mshr
+    {
+        discrete_t block = 0;
+        discrete_t done = 0;
+    };
+    // An access handed over but not timed yet; its requests are the next
+    // `requests` entries of `outgoing`.
+    struct Pending
+    {
+        AccessType type;
+        discrete_t block;
+        bool hit;
+        bool wroteBack;
+        discrete_t translation;
+        discrete_t arrival;
+        size_t requests;
+    };
+    discrete_t hitLatency;
+    discrete_t memoryLatency;
+    discrete_t writebackLatency;
+    discrete_t issueInterval;
+    discrete_t bankCycles;
+    std::vector< Mshr > mshrs;
+    std::vector< discrete_t > bankFree;
+    std::shared_ptr< DRAM > dram;
+    std::shared_ptr< Scheduler > scheduler;
+    uint32_t stepHandler = 0;
+    uint32_t fillHandler = 0;
+    std::deque< Pending > inbox;
+    std::vector< MemoryRequest > outgoing;
+    size_t sent = 0;
+    // When the oldest pending access issued and started, and whether it is
+    // waiting for an MSHR.
+    discrete_t issue = 0;
+    discrete_t start = 0;
+    bool waiting = false;
+    // Earliest cycle the next access may issue, and the last completion.
+    discrete_t clock = 0;
+    discrete_t end = 0;
+    discrete_t latencies = 0;
+    discrete_t merged = 0;
+    discrete_t mshrStalls = 0;
+    discrete_t bankStalls = 0;
+    discrete_t mshrBusy = 0;
+    std::array< Histogram , 2 > histograms = {};
+    discrete_t Latency( bool hit , bool wroteBack , discrete_t translation , discrete_t memory ) const;
+    discrete_t Memory( discrete_t time , std::span< const MemoryRequest > requests );
+    void Attach( std::shared_ptr< Scheduler > shared );
+    void Begin();
+    void Step();
+    bool NonBlocking( const Pending &access , std::span< const MemoryRequest > requests , discrete_t &latency );
+    static void Stepped( void *timing );
+    static void Filled( void *timing );
+public:
+    Timing( const Options &options );
+    ~Timing();
+    // Shares one DRAM, and the scheduler running everything that uses it.
+    void SetMemory( std::shared_ptr< DRAM > shared , std::shared_ptr< Scheduler > clock );
+    // Hands over an access to `block` that was made at trace time `arrival`.
+    // `requests` is what the access sent to memory.
+    void Access( AccessType type , discrete_t block , bool hit , bool wroteBack , discrete_t translation , discrete_t arrival ,
+                 const std::vector< MemoryRequest > &requests );
+    // Earliest cycle an access not handed over yet could issue at, if the
+    // trace has reached `arrival`; unbounded while accesses are pending.
+    discrete_t Earliest( discrete_t arrival ) const;
+    size_t Backlog() const;
+    // Times every access handed over.
+    void Finish();
+    void Merge( const Timing &other );
+    void Report( CacheReport &report ) const;
+    // Bucket b counts latencies in [2^b, 2^(b+1)), bucket 0 also holds 0.
+    const Histogram &Latencies( AccessType type ) const;
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef TINY_LFU_HPP
+#define TINY_LFU_HPP
+
+#include "Backend/CountMinSketch.hpp"
+#include "Backend/DirectoryPolitics.hpp"
+
+#include <vector>
+
+struct TinyLFUNode
+{
+    discrete_t key = 0;
+    discrete_t way = 0;
+    Link link;
+    uint8_t list = 0;
+};
+
+// W-TinyLFU (Einziger et al., 2017), run per set. Misses enter a small window
+// LRU; the block it pushes out only replaces the main region's victim if the
+// sketch says it is accessed more often, otherwise it is the one evicted. The
+// main region is a segmented LRU split into probation and protected.
+class TinyLFU : public DirectoryPolitics< TinyLFUNode >
+{
+private:
+    enum List : uint8_t { WINDOW , PROBATION , PROTECTED };
+    using TinyLFUList = IntrusiveList< TinyLFUNode , &TinyLFUNode::link >;
+    struct Set
+    {
+        TinyLFUList lists[3];
+    };
+    std::vector< Set > sets;
+    CountMinSketch sketch;
+    discrete_t windowSize;
+    discrete_t protectedSize;
+    void Move( Set &set , uint32_t node , List to );
+public:
+    TinyLFU( discrete_t associativity , discrete_t nstes , discrete_t windowPercent , discrete_t protectedPercent );
+    ~TinyLFU();
+    void Miss( discrete_t index , discrete_t tag ) override;
+    discrete_t GetBlock( discrete_t index ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
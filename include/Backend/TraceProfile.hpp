@@ -0,0 +1,43 @@
+#ifndef TRACE_PROFILE_HPP
+#define TRACE_PROFILE_HPP
+
+#include "Backend/HyperLogLog.hpp"
+#include "Backend/SpaceSaving.hpp"
+#include "common/Types.hpp"
+
+#include <array>
+
+// One pass over a trace's block addresses in fixed memory: distinct blocks in
+// the current window and overall, the strides between consecutive accesses
+// and the hottest blocks.
+class TraceProfile
+{
+public:
+    static constexpr discrete_t BUCKETS = 33;
+    // Strides in blocks by sign and magnitude: bucket 0 counts zeros and
+    // bucket b magnitudes in [2^(b-1), 2^b).
+    using Histogram = std::array< discrete_t , BUCKETS >;
+    static discrete_t From( discrete_t bucket );
+private:
+    bits_t offset;
+    HyperLogLog window;
+    HyperLogLog footprint;
+    SpaceSaving hot;
+    Histogram forward = {};
+    Histogram backward = {};
+    discrete_t last = 0;
+    discrete_t accesses = 0;
+public:
+    TraceProfile( bits_t offset , bits_t precision , discrete_t counters );
+    ~TraceProfile();
+    void Access( addr_t addr );
+    // Distinct blocks since the last call.
+    discrete_t EndWindow();
+    discrete_t Footprint() const;
+    discrete_t Accesses() const;
+    const Histogram &Forward() const;
+    const Histogram &Backward() const;
+    std::vector< SpaceSaving::Counter > Hottest( discrete_t count ) const;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef TWO_Q_HPP
+#define TWO_Q_HPP
+
+#include "Backend/DirectoryPolitics.hpp"
+
+#include <vector>
+
+struct TwoQNode
+{
+    discrete_t key = 0;
+    discrete_t way = 0;
+    Link link;
+    uint8_t list = 0;
+};
+
+// Full 2Q (Johnson and Shasha, VLDB 1994), run per set. New blocks enter the
+// A1in FIFO, and only blocks that come back while remembered in the A1out ghost
+// FIFO are promoted to the Am LRU, so a scan never reaches Am.
+class TwoQ : public DirectoryPolitics< TwoQNode >
+{
+private:
+    enum List : uint8_t { A1IN , A1OUT , AM };
+    using TwoQList = IntrusiveList< TwoQNode , &TwoQNode::link >;
+    struct Set
+    {
+        TwoQList lists[3];
+    };
+    std::vector< Set > sets;
+    discrete_t kin;
+    discrete_t kout;
+    void Move( Set &set , uint32_t node , List to );
+public:
+    TwoQ( discrete_t associativity , discrete_t nstes , discrete_t inPercent , discrete_t outPercent );
+    ~TwoQ();
+    discrete_t GetBlock( discrete_t index ) override;
+    void Refresh( discrete_t index , discrete_t block ) override;
+    void Serialize( Archive &archive ) override;
+    void Insert( discrete_t index , discrete_t block ) override;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef WAY_PARTITION_HPP
+#define WAY_PARTITION_HPP
+
+#include "common/Archive.hpp"
+#include "common/Options.hpp"
+#include "common/Types.hpp"
+
+#include <vector>
+
+// Way partitioning of a cache shared by several programs: a program only
+// fills the ways of its mask. Masks are either fixed (--cat, as with Intel
+// CAT) or chosen every interval by utility-based partitioning (UCP, Qureshi
+// and Patt). For UCP every program has a utility monitor: an LRU stack of
+// tags as deep as the cache is associative on a sample of the sets, whose
+// per-position hit counters tell how many hits each extra way would bring.
+class WayPartition
+{
+public:
+    // Ways, accesses and hits of every program over one interval.
+    struct Interval
+    {
+        discrete_t end = 0;
+        std::vector< discrete_t > ways;
+        std::vector< discrete_t > accesses;
+        std::vector< discrete_t > hits;
+        void Serialize( Archive &archive ) { archive( end )( ways )( accesses )( hits ); }
+    };
+private:
+    discrete_t associativity;
+    discrete_t programs;
+    std::vector< uint64_t > masks;
+    bool utility;
+    discrete_t length;
+    discrete_t stride;
+    discrete_t samples;
+    // Monitor stacks, most recent first, [program * samples + sample].
+    std::vector< std::vector< discrete_t > > stacks;
+    // Monitor hits per stack position, [program * associativity + position].
+    std::vector< discrete_t > positionHits;
+    discrete_t accesses = 0;
+    Interval current;
+    std::vector< Interval > history;
+    void Monitor( discrete_t index , discrete_t tag , discrete_t program );
+    void Close();
+    void Repartition();
+    void Assign( const std::vector< discrete_t > &ways );
+public:
+    WayPartition( const Options &options , discrete_t nsets , discrete_t associativity , discrete_t programs );
+    ~WayPartition();
+    uint64_t Ways( uint16_t program ) const;
+    void Access( discrete_t index , discrete_t tag , uint16_t program , bool hit );
+    // Every interval so far, the running one included.
+    std::vector< Interval > History() const;
+    void Serialize( Archive &archive );
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef XOR_INDEXING_HPP
+#define XOR_INDEXING_HPP
+
+#include "Backend/Indexing.hpp"
+
+// XOR-folded indexing: every index-sized slice of the tag is XORed into the
+// low bits, so power-of-two strides spread over the sets instead of piling up
+// in one. The tag is unchanged, which keeps the block recoverable. Needs a
+// power-of-two set count.
+class XorIndexing : public Indexing
+{
+private:
+    bits_t bits;
+public:
+    XorIndexing( discrete_t nsets );
+    ~XorIndexing();
+    discrete_t Index( discrete_t block , [[maybe_unused]] discrete_t way ) const override;
+    discrete_t Tag( discrete_t block ) const override;
+    discrete_t Block( discrete_t index , discrete_t tag ) const override;
+};
+
+#endif
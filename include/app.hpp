@@ -2,9 +2,13 @@
 #define APP_HPP
 
 #include "Backend/Backend.hpp"
+#include "Backend/SimPoint.hpp"
 #include "Frontend/Frontend.hpp"
+#include "common/Options.hpp"
 
+#include <fstream>
 #include <memory>
+#include <ostream>
 #include <queue>
 #include <string>
 #include <vector>
@@ -16,11 +20,41 @@ struct App {
 
 private:
   App(std::unique_ptr<Backend> &&backend, std::unique_ptr<Frontend> &&frontend,
-      std::string &path);
+      std::string &path, const Options &options, std::string signature);
+
+  auto checkpoint(discrete_t position) -> void;
+  auto awaitWriter() -> void;
+  auto simulate(discrete_t until) -> void;
+  auto variants(const std::vector<std::string> &names) -> void;
+  auto runVariant(const std::string &name) -> std::string;
+  auto printVariants(const std::vector<std::string> &names,
+                     const std::vector<std::string> &outputs,
+                     const std::vector<bool> &failed) -> void;
+  auto print(std::ostream &out) -> void;
+  auto sample(discrete_t position) -> void;
+  auto dumpHeatmap(discrete_t position) -> void;
+  auto characterize() -> void;
+  auto skip(discrete_t until) -> void;
+  auto simpoints() -> void;
 
   std::unique_ptr<Frontend> frontend;
   std::unique_ptr<Backend> backend;
   std::queue<addr_t> addrs;
+  std::string path;
+  Options options;
+  // The arguments that shape the simulation, kept in checkpoints.
+  std::string signature;
+  discrete_t total = 0;
+  // Process writing the last checkpoint, if any.
+  int writer = 0;
+  // Time series of --intervals and the counters at the last sample.
+  std::unique_ptr<std::ofstream> intervals;
+  CacheReport last;
+  // Bytes of the output files when the resumed checkpoint was taken.
+  std::vector<discrete_t> lengths;
+  std::unique_ptr<std::ofstream> heatmap;
+  // Intervals of the trace and their features, with --simpoints.
+  std::unique_ptr<SimPoint> phases;
 
   bool running;
 };
@@ -0,0 +1,127 @@
+#ifndef ARCHIVE_HPP
+#define ARCHIVE_HPP
+
+#include <deque>
+#include <istream>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// What Archive does with each kind of member.
+namespace archive {
+template <typename T> struct Pointer : std::false_type {};
+template <typename T> struct Pointer<std::unique_ptr<T>> : std::true_type {};
+template <typename T> struct Pointer<std::shared_ptr<T>> : std::true_type {};
+// Contiguous, so trivially copyable elements go in one write.
+template <typename T> struct Vector : std::false_type {};
+template <typename T> struct Vector<std::vector<T>> : std::true_type {};
+template <> struct Vector<std::string> : std::true_type {};
+template <typename T> struct Sequence : std::false_type {};
+template <typename T> struct Sequence<std::list<T>> : std::true_type {};
+template <typename T> struct Sequence<std::deque<T>> : std::true_type {};
+template <typename T> struct Queue : std::false_type {};
+template <typename T> struct Queue<std::queue<T>> : std::true_type {};
+template <typename T> struct Map : std::false_type {};
+template <typename K, typename V>
+struct Map<std::unordered_map<K, V>> : std::true_type {};
+} // namespace archive
+
+// Binary stream for checkpoints. A component gets one `Serialize(Archive &)`
+// member listing its state, which saves or restores depending on how the
+// archive was made, so the two directions cannot drift apart. Trivially
+// copyable values (random engines included) are copied as raw bytes and
+// containers as their size then their elements, so a checkpoint is only read
+// back by the same build with the same arguments. Pointers are followed, both
+// sides are expected to have the same objects allocated.
+class Archive {
+public:
+  explicit Archive(std::ostream &out) : out(&out) {}
+  explicit Archive(std::istream &in) : in(&in) {}
+
+  auto saving() const -> bool { return out != nullptr; }
+  auto good() const -> bool { return saving() ? out->good() : in->good(); }
+
+  template <typename T> auto operator()(T &value) -> Archive & {
+    if constexpr (requires { value.Serialize(*this); }) {
+      value.Serialize(*this);
+    } else if constexpr (requires { value.serialize(*this); }) {
+      value.serialize(*this);
+    } else if constexpr (archive::Pointer<T>::value) {
+      if (value) {
+        (*this)(*value);
+      }
+    } else if constexpr (archive::Vector<T>::value) {
+      resize(value);
+      if constexpr (std::is_trivially_copyable_v<typename T::value_type>) {
+        raw(value.data(), value.size() * sizeof(typename T::value_type));
+      } else {
+        for (auto &element : value) {
+          (*this)(element);
+        }
+      }
+    } else if constexpr (archive::Sequence<T>::value) {
+      resize(value);
+      for (auto &element : value) {
+        (*this)(element);
+      }
+    } else if constexpr (archive::Queue<T>::value) {
+      (*this)(Open<T>::container(value));
+    } else if constexpr (archive::Map<T>::value) {
+      size_t size = value.size();
+      raw(&size, sizeof(size));
+      if (saving()) {
+        for (auto &[key, element] : value) {
+          typename T::key_type copy = key;
+          (*this)(copy);
+          (*this)(element);
+        }
+      } else {
+        value.clear();
+        for (size_t i = 0; i < size && in->good(); i++) {
+          typename T::key_type key{};
+          (*this)(key);
+          (*this)(value[key]);
+        }
+      }
+    } else {
+      static_assert(std::is_trivially_copyable_v<T>,
+                    "give the type a Serialize(Archive &) member");
+      raw(&value, sizeof(T));
+    }
+    return *this;
+  }
+
+private:
+  // std::queue keeps its container protected.
+  template <typename Q> struct Open : Q {
+    static auto container(Q &queue) -> typename Q::container_type & {
+      return queue.*&Open::c;
+    }
+  };
+
+  template <typename T> auto resize(T &value) -> void {
+    size_t size = value.size();
+    raw(&size, sizeof(size));
+    if (!saving()) {
+      value.resize(in->good() ? size : 0);
+    }
+  }
+
+  auto raw(void *data, size_t bytes) -> void {
+    if (saving()) {
+      out->write(static_cast<const char *>(data), (std::streamsize)bytes);
+    } else {
+      in->read(static_cast<char *>(data), (std::streamsize)bytes);
+    }
+  }
+
+  std::ostream *out = nullptr;
+  std::istream *in = nullptr;
+};
+
+#endif // ARCHIVE_HPP
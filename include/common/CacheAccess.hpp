@@ -8,6 +8,8 @@ struct CacheAccess {
   discrete_t block = 0;
 
   AccessResult res = AccessResult::UNKOWN;
+  // The miss was not allocated, `block` is meaningless.
+  bool bypass = false;
 };
 
 #endif // CACHE_ACCESS_HPP
\ No newline at end of file
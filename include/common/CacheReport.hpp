@@ -21,6 +21,69 @@ struct CacheReport {
     compulsory_miss_rate = (percentage_t)compulsory_miss / (percentage_t)miss;
     conflict_miss_rate = (percentage_t)conflict_miss / (percentage_t)miss;
     capacity_miss_rate = (percentage_t)capacity_miss / (percentage_t)miss;
+    if (latency_cycles > 0) {
+      amat = (percentage_t)latency_cycles / (percentage_t)accesses;
+    }
+    if (total_cycles > 0) {
+      mshr_occupancy = (percentage_t)mshr_busy_cycles / (percentage_t)total_cycles;
+    }
+    if (lifetime_evictions > 0) {
+      never_hit_rate = (percentage_t)never_hit_evictions /
+                       (percentage_t)lifetime_evictions;
+    }
+    if (live_time + dead_time > 0) {
+      dead_fraction =
+          (percentage_t)dead_time / (percentage_t)(live_time + dead_time);
+    }
+    if (dram_requests > 0) {
+      dram_row_hit_rate = (percentage_t)dram_row_hits / (percentage_t)dram_requests;
+      dram_latency = (percentage_t)dram_latency_cycles / (percentage_t)dram_requests;
+    }
+    if (dram_cycles > 0) {
+      dram_bandwidth = (percentage_t)dram_bytes / (percentage_t)dram_cycles;
+    }
+    if (predictions > 0) {
+      prediction_accuracy =
+          (percentage_t)correct_predictions / (percentage_t)predictions;
+    }
+  }
+
+  // Adds the counters of `other`; rates are left for Calculate().
+  void Accumulate(const CacheReport &other) {
+    accesses += other.accesses;
+    hits += other.hits;
+    miss += other.miss;
+    compulsory_miss += other.compulsory_miss;
+    conflict_miss += other.conflict_miss;
+    capacity_miss += other.capacity_miss;
+    bypasses += other.bypasses;
+    predictions += other.predictions;
+    correct_predictions += other.correct_predictions;
+    tag_misses += other.tag_misses;
+    sector_misses += other.sector_misses;
+    bytes_fetched += other.bytes_fetched;
+    bytes_written_back += other.bytes_written_back;
+    tlb_l1_hits += other.tlb_l1_hits;
+    tlb_l2_hits += other.tlb_l2_hits;
+    page_walks += other.page_walks;
+    walk_cycles += other.walk_cycles;
+    coherence_misses += other.coherence_misses;
+    invalidations += other.invalidations;
+    upgrades += other.upgrades;
+    interventions += other.interventions;
+    // Cores run side by side, the slowest one sets the runtime.
+    total_cycles = total_cycles > other.total_cycles ? total_cycles
+                                                     : other.total_cycles;
+    latency_cycles += other.latency_cycles;
+    merged_misses += other.merged_misses;
+    mshr_stall_cycles += other.mshr_stall_cycles;
+    bank_stall_cycles += other.bank_stall_cycles;
+    mshr_busy_cycles += other.mshr_busy_cycles;
+    evictions += other.evictions;
+    lifetime_evictions += other.lifetime_evictions;
+    never_hit_evictions += other.never_hit_evictions;
+    live_time += other.live_time;
+    dead_time += other.dead_time;
   }
 
   discrete_t accesses = 0;
@@ -34,6 +97,71 @@ struct CacheReport {
   percentage_t compulsory_miss_rate = 0.0f;
   percentage_t capacity_miss_rate = 0.0f;
   percentage_t conflict_miss_rate = 0.0f;
+
+  // The GUI reads the fields above in declaration order, new counters go below.
+
+  // Misses left out of the cache by a dead block predictor.
+  discrete_t bypasses = 0;
+  // Reuse predictions checked when their block left the cache.
+  discrete_t predictions = 0;
+  discrete_t correct_predictions = 0;
+  percentage_t prediction_accuracy = 0.0f;
+  // Misses on the tag and misses on a sector of a block whose tag was present.
+  // `miss` counts both, the miss classes only the former.
+  discrete_t tag_misses = 0;
+  discrete_t sector_misses = 0;
+  discrete_t bytes_fetched = 0;
+  discrete_t bytes_written_back = 0;
+  // Address translation, filled when a TLB is modelled.
+  discrete_t tlb_l1_hits = 0;
+  discrete_t tlb_l2_hits = 0;
+  discrete_t page_walks = 0;
+  discrete_t walk_cycles = 0;
+  // MESI traffic, filled when several cores share the trace. Invalidations,
+  // upgrades and interventions are counted on the core that caused them.
+  discrete_t coherence_misses = 0;
+  discrete_t invalidations = 0;
+  discrete_t upgrades = 0;
+  discrete_t interventions = 0;
+  // Coherence misses split by whether the core used data another core wrote.
+  discrete_t true_sharing_misses = 0;
+  discrete_t false_sharing_misses = 0;
+  // Timing model, filled with --timing. Total cycles is the estimated
+  // runtime, latency cycles the sum of every access's latency.
+  discrete_t total_cycles = 0;
+  discrete_t latency_cycles = 0;
+  percentage_t amat = 0.0f;
+  // Non-blocking cache, with --mshrs. Occupancy is the average number of
+  // busy MSHRs.
+  discrete_t merged_misses = 0;
+  discrete_t mshr_stall_cycles = 0;
+  discrete_t bank_stall_cycles = 0;
+  discrete_t mshr_busy_cycles = 0;
+  percentage_t mshr_occupancy = 0.0f;
+  // DRAM behind the cache, with --dram. Bandwidth is in bytes per cycle over
+  // the span from the first request to the last completion. Shared by every
+  // core, so Accumulate leaves it alone.
+  discrete_t dram_requests = 0;
+  discrete_t dram_row_hits = 0;
+  discrete_t dram_row_misses = 0;
+  discrete_t dram_row_conflicts = 0;
+  discrete_t dram_bytes = 0;
+  discrete_t dram_latency_cycles = 0;
+  discrete_t dram_cycles = 0;
+  percentage_t dram_row_hit_rate = 0.0f;
+  percentage_t dram_latency = 0.0f;
+  percentage_t dram_bandwidth = 0.0f;
+  // Valid lines replaced by a fill.
+  discrete_t evictions = 0;
+  // Generations of evicted blocks with --lifetimes, times in accesses. The
+  // dead fraction is the share of their time in the cache spent after their
+  // last use.
+  discrete_t lifetime_evictions = 0;
+  discrete_t never_hit_evictions = 0;
+  discrete_t live_time = 0;
+  discrete_t dead_time = 0;
+  percentage_t never_hit_rate = 0.0f;
+  percentage_t dead_fraction = 0.0f;
 };
 
 #endif // CACHE_HPP
@@ -2,7 +2,7 @@
 #define CACHE_SPECS_HPP
 
 #include "common/Types.hpp"
-#include <cmath>
+#include <bit>
 #include <string>
 
 struct CacheSpecs {
@@ -21,6 +21,42 @@ struct CacheSpecs {
     if (string.compare("F") == 0) {
       return REPL::FIFO;
     }
+    if (string.compare("SRRIP") == 0) {
+      return REPL::SRRIP;
+    }
+    if (string.compare("BRRIP") == 0) {
+      return REPL::BRRIP;
+    }
+    if (string.compare("DRRIP") == 0) {
+      return REPL::DRRIP;
+    }
+    if (string.compare("DIP") == 0) {
+      return REPL::DIP;
+    }
+    if (string.compare("PLRU") == 0) {
+      return REPL::PLRU;
+    }
+    if (string.compare("NRU") == 0) {
+      return REPL::NRU;
+    }
+    if (string.compare("ARC") == 0) {
+      return REPL::ARC;
+    }
+    if (string.compare("2Q") == 0) {
+      return REPL::TWOQ;
+    }
+    if (string.compare("LIRS") == 0) {
+      return REPL::LIRS;
+    }
+    if (string.compare("LFU") == 0) {
+      return REPL::LFU;
+    }
+    if (string.compare("TINYLFU") == 0) {
+      return REPL::TINYLFU;
+    }
+    if (string.compare("SHIP") == 0) {
+      return REPL::SHIP;
+    }
     return REPL::RANDOM;
   }
   const discrete_t nsets;
@@ -34,8 +70,8 @@ struct CacheSpecs {
     const bits_t tag;
 
     Bits(discrete_t addrSize, discrete_t nsets, discrete_t block)
-        : index(static_cast<bits_t>(ceilf(log2f((float)nsets)))),
-          offset(static_cast<uint8_t>(ceilf(log2f((float)block)))),
+        : index(static_cast<bits_t>(std::bit_width(nsets - 1))),
+          offset(static_cast<uint8_t>(std::bit_width(block - 1))),
           tag(static_cast<uint8_t>(addrSize - index - offset)) {}
   } bits;
 };
@@ -0,0 +1,52 @@
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include "common/Types.hpp"
+
+#include <span>
+#include <string>
+#include <unordered_map>
+
+// Optional `--key=value` / `--flag` arguments given after the trace path.
+struct Options {
+  Options() = default;
+
+  explicit Options(std::span<std::string> args) {
+    for (const std::string &arg : args) {
+      if (arg.rfind("--", 0) != 0) {
+        continue;
+      }
+      size_t eq = arg.find('=');
+      if (eq == std::string::npos) {
+        values[arg.substr(2)] = "";
+      } else {
+        values[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+      }
+    }
+  }
+
+  auto has(const std::string &key) const -> bool {
+    return values.find(key) != values.end();
+  }
+
+  auto get(const std::string &key, const std::string &fallback) const
+      -> std::string {
+    auto it = values.find(key);
+    return it == values.end() ? fallback : it->second;
+  }
+
+  auto get(const std::string &key, discrete_t fallback) const -> discrete_t {
+    auto it = values.find(key);
+    if (it == values.end() || it->second.empty()) {
+      return fallback;
+    }
+    return std::stoull(it->second);
+  }
+
+  auto erase(const std::string &key) -> void { values.erase(key); }
+
+private:
+  std::unordered_map<std::string, std::string> values;
+};
+
+#endif // OPTIONS_HPP
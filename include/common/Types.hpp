@@ -13,8 +13,25 @@ enum class AccessResult {
   COMPULSORY_MISS,
   CONFLICT_MISS,
   CAPACITY_MISS,
+  // The tag was present but not the sector holding the address.
+  SECTOR_MISS,
+  // The line was invalidated by another core's write.
+  COHERENCE_MISS,
   UNKOWN
 };
-enum class REPL { LRU, FIFO, RANDOM };
+enum class AccessType : uint8_t { READ, WRITE };
+// MESI state of a line; private caches of a single core only use E and M.
+enum class Coherence : uint8_t { MODIFIED, EXCLUSIVE, SHARED, INVALID };
+enum class REPL { LRU, FIFO, RANDOM, SRRIP, BRRIP, DRRIP, DIP, PLRU, NRU, ARC, TWOQ, LIRS, LFU, TINYLFU, SHIP };
+
+// What a trace line says besides the address.
+struct TraceEntry {
+  AccessType type = AccessType::READ;
+  uint16_t core = 0;
+  // Which of the traces sharing the cache the access comes from.
+  uint16_t program = 0;
+  // Cycle the access was made at, the line number unless the trace says.
+  discrete_t time = 0;
+};
 
 #endif // TYPES_HPP
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Backend/ARC.hpp"
+
+#include <algorithm>
+
+ARC::ARC( discrete_t associativity , discrete_t nstes ) : DirectoryPolitics( associativity , nstes , 2 * associativity ) {
+    sets = std::vector< Set >( nstes );
+}
+
+ARC::~ARC() {
+    sets.clear();
+}
+
+void ARC::Move( Set &set , uint32_t node , List to ) {
+    set.lists[nodes[node].list].Remove( nodes , node );
+    set.lists[to].PushFront( nodes , node );
+    nodes[node].list = to;
+}
+
+void ARC::Miss( discrete_t index , discrete_t tag ) {
+    DirectoryPolitics::Miss( index , tag );
+    if ( pendingNode == NONE ) {
+        return;
+    }
+    Set &set = sets[index];
+    discrete_t b1 = set.lists[B1].size , b2 = set.lists[B2].size;
+    if ( nodes[pendingNode].list == B1 ) {
+        set.p = std::min( set.p + std::max< discrete_t >( 1 , b2 / b1 ) , associativity );
+    } else {
+        discrete_t delta = std::max< discrete_t >( 1 , b1 / b2 );
+        set.p = set.p > delta ? set.p - delta : 0;
+    }
+}
+
+discrete_t ARC::GetBlock( discrete_t index ) {
+    Set &set = sets[index];
+    discrete_t t1 = set.lists[T1].size;
+    if ( t1 + set.lists[T2].size < associativity ) {
+        return 0; // The set still has invalid ways, the cache fills one of those.
+    }
+    bool ghostB2 = pendingNode != NONE && nodes[pendingNode].list == B2;
+    uint32_t victim;
+    if ( t1 > 0 && ( t1 > set.p || ( ghostB2 && t1 == set.p ) || set.lists[T2].Empty() ) ) {
+        victim = set.lists[T1].Back();
+        Move( set , victim , B1 );
+    } else {
+        victim = set.lists[T2].Back();
+        Move( set , victim , B2 );
+    }
+    return nodes[victim].way;
+}
+
+void ARC::Refresh( discrete_t index , discrete_t block ) {
+    Move( sets[index] , NodeAt( index , block ) , T2 );
+}
+
+void ARC::Insert( discrete_t index , discrete_t block ) {
+    Set &set = sets[index];
+    uint32_t node = pendingNode;
+    if ( node != NONE ) {
+        Move( set , node , T2 );
+    } else {
+        // Keep |T1| + |B1| <= c and the whole directory <= 2c.
+        if ( set.lists[T1].size + set.lists[B1].size >= associativity ) {
+            if ( !set.lists[B1].Empty() ) {
+                uint32_t ghost = set.lists[B1].Back();
+                set.lists[B1].Remove( nodes , ghost );
+                Release( ghost );
+            }
+        } else if ( set.lists[T1].size + set.lists[T2].size + set.lists[B1].size + set.lists[B2].size >= 2 * associativity ) {
+            uint32_t ghost = set.lists[B2].Back();
+            set.lists[B2].Remove( nodes , ghost );
+            Release( ghost );
+        }
+        node = Allocate( pendingKey );
+        nodes[node].list = T1;
+        set.lists[T1].PushFront( nodes , node );
+    }
+    Place( index , block , node );
+    pendingNode = NONE;
+}
+
+void ARC::Serialize( Archive &archive ) {
+    DirectoryPolitics::Serialize( archive );
+    archive( sets );
+}
@@ -2,82 +2,604 @@
 #include "Backend/LRU.hpp"
 #include "Backend/RANDOM.hpp"
 #include "Backend/FIFO.hpp"
+#include "Backend/RRIP.hpp"
+#include "Backend/DIP.hpp"
+#include "Backend/PLRU.hpp"
+#include "Backend/NRU.hpp"
+#include "Backend/ARC.hpp"
+#include "Backend/TwoQ.hpp"
+#include "Backend/LIRS.hpp"
+#include "Backend/LFU.hpp"
+#include "Backend/TinyLFU.hpp"
+#include "Backend/SHiP.hpp"
+#include "Backend/ModuloIndexing.hpp"
+#include "Backend/XorIndexing.hpp"
+#include "Backend/SkewedIndexing.hpp"
+#include "Backend/TLB.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <iostream>
 #include <random>
 
-Cache::Cache( std::span< std::string > command) : Backend(setCacheSpecs(command)){
+Cache::Cache( std::span< std::string > command , const Options &options ) : Backend(setCacheSpecs(command)){
   cache = std::vector< std::vector< CacheBlock > >( __specs.nsets );
   for ( discrete_t index = 0 ; index < __specs.nsets ; index++ ) {
     cache[index] = std::vector< CacheBlock >( __specs.assoc );
   }
-  switch ( __specs.substitutionPolitics ) {
+  setFill = std::vector< discrete_t >( __specs.nsets , 0 );
+  wayFill = std::vector< discrete_t >( __specs.assoc , 0 );
+  if ( options.has( "timing" ) || options.has( "dram" ) ) {
+    timing = std::make_unique<Timing>( options );
+  }
+  if ( options.has( "dram" ) ) {
+    timing.get()->SetMemory( std::make_shared<DRAM>( options , __specs.block ) , nullptr );
+  }
+  if ( options.has( "heatmap" ) ) {
+    heatmap = std::make_unique<Heatmap>( __specs.nsets , ( bits_t ) std::min< discrete_t >( options.get( "heatmap-region" , 12 ) , 32 ) );
+  }
+  if ( options.has( "lifetimes" ) ) {
+    lifetimes = std::make_unique<Lifetimes>( __specs.nsets * __specs.assoc );
+  }
+  if ( options.has( "tlb" ) ) {
+    tlb = std::make_unique<TLB>( options );
+  }
+  if ( options.has( "mapping" ) ) {
+    mapper = std::make_shared<PageMapper>( PageMapper::Kind( options.get( "mapping" , "identity" ) ) , options ,
+                                           __specs.nsets * __specs.block * __specs.assoc , __specs.assoc );
+  }
+  discrete_t sectors = options.get( "sectors" , 1 );
+  if ( sectors == 0 || sectors > 64 || sectors > __specs.block || ( sectors & ( sectors - 1 ) ) != 0 ) {
+    std::cout << "Sectors must be a power of two up to 64 and the block size\n\tHALTING PROGRAM\n";
+    exit(0);
+  }
+  sectorMask = sectors - 1;
+  sectorShift = ( bits_t ) ( __specs.bits.offset - std::countr_zero( sectors ) );
+  sectorBytes = __specs.block / sectors;
+  std::string function = options.get( "index" , "modulo" );
+  if ( function == "xor" ) {
+    if ( ( __specs.nsets & ( __specs.nsets - 1 ) ) != 0 ) {
+      std::cout << "XOR indexing needs a power of two number of sets\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    indexing = std::make_unique<XorIndexing>( __specs.nsets );
+  } else if ( function == "skew" ) {
+    indexing = std::make_unique<SkewedIndexing>( __specs.nsets , __specs.assoc );
+    skewStamps = std::vector< discrete_t >( __specs.nsets * __specs.assoc , 0 );
+  } else if ( function == "modulo" ) {
+    indexing = std::make_unique<ModuloIndexing>( __specs.nsets );
+  } else {
+    std::cout << "--index is modulo, xor or skew\n\tHALTING PROGRAM\n";
+    exit(0);
+  }
+  if ( options.has( "programs" ) ) {
+    discrete_t entries = std::bit_ceil( 4 * __specs.nsets * __specs.assoc );
+    evictions = std::vector< Eviction >( entries );
+    evictionShift = ( bits_t ) ( 64 - std::countr_zero( entries ) );
+  }
+  if ( options.has( "cat" ) || options.has( "ucp" ) ) {
+    if ( indexing.get()->Skewed() || __specs.assoc > 64 ) {
+      std::cout << "Way partitioning needs set indexing and up to 64 ways\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    Partitionable( __specs.substitutionPolitics );
+    std::string list = options.get( "programs" , "" );
+    discrete_t count = 1 + ( discrete_t ) std::count( list.begin() , list.end() , ',' ) + ( list.empty() ? 0 : 1 );
+    partition = std::make_unique<WayPartition>( options , __specs.nsets , __specs.assoc , count );
+  }
+  if ( __specs.assoc > LINEAR_LOOKUP_WAYS && !indexing.get()->Skewed() ) {
+    blocks = std::make_unique<FlatMap>( __specs.nsets * __specs.assoc );
+  }
+  substitutionPolitics = MakePolicy( __specs.substitutionPolitics , options );
+}
+std::unique_ptr< SubstitutionPolitics > Cache::MakePolicy( REPL repl , const Options &options ) {
+  switch ( repl ) {
   case REPL::FIFO:
-    substitutionPolitics = std::make_unique<FIFO>( __specs.assoc , __specs.nsets );
-    break;
+    return std::make_unique<FIFO>( __specs.assoc , __specs.nsets );
   case REPL::RANDOM:
-    substitutionPolitics = std::make_unique<RANDOM>( __specs.assoc , __specs.nsets );
-    break;
+    return std::make_unique<RANDOM>( __specs.assoc , __specs.nsets ,
+                                     options.has( "deterministic" ) ? options.get( "seed" , 1 ) : std::random_device{}() );
   case REPL::LRU:
-    substitutionPolitics = std::make_unique<LRU>( __specs.assoc , __specs.nsets );
-    break;
+    return std::make_unique<LRU>( __specs.assoc , __specs.nsets );
+  case REPL::SRRIP:
+  case REPL::BRRIP:
+  case REPL::DRRIP:
+    return std::make_unique<RRIP>( __specs.assoc , __specs.nsets , RRIPInsertion( repl ) ,
+                                   ( bits_t ) std::clamp< discrete_t >( options.get( "rrpv-bits" , 2 ) , 1 , 8 ) ,
+                                   options.get( "bimodal-throttle" , 32 ) , options.get( "leader-sets" , 32 ) ,
+                                   ( bits_t ) std::clamp< discrete_t >( options.get( "psel-bits" , 10 ) , 1 , 63 ) );
+  case REPL::DIP:
+    return std::make_unique<DIP>( __specs.assoc , __specs.nsets , options.get( "bimodal-throttle" , 32 ) ,
+                                  options.get( "leader-sets" , 32 ) ,
+                                  ( bits_t ) std::clamp< discrete_t >( options.get( "psel-bits" , 10 ) , 1 , 63 ) );
+  case REPL::PLRU:
+    if ( __specs.assoc > 64 || ( __specs.assoc & ( __specs.assoc - 1 ) ) != 0 ) {
+      std::cout << "PLRU needs a power of two associativity up to 64\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    return std::make_unique<PLRU>( __specs.assoc , __specs.nsets );
+  case REPL::NRU:
+    if ( __specs.assoc > 64 ) {
+      std::cout << "NRU supports up to 64 ways\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    return std::make_unique<NRU>( __specs.assoc , __specs.nsets );
+  case REPL::ARC:
+    return std::make_unique<ARC>( __specs.assoc , __specs.nsets );
+  case REPL::TWOQ:
+    return std::make_unique<TwoQ>( __specs.assoc , __specs.nsets , options.get( "2q-in" , 25 ) , options.get( "2q-out" , 50 ) );
+  case REPL::LIRS:
+    return std::make_unique<LIRS>( __specs.assoc , __specs.nsets , options.get( "lirs-hir" , 1 ) );
+  case REPL::LFU:
+    return std::make_unique<LFU>( __specs.assoc , __specs.nsets , options.get( "lfu-aging" , 16 * __specs.assoc ) );
+  case REPL::TINYLFU:
+    return std::make_unique<TinyLFU>( __specs.assoc , __specs.nsets , options.get( "tinylfu-window" , 1 ) ,
+                                      options.get( "tinylfu-protected" , 80 ) );
+  case REPL::SHIP: {
+    // Signatures hash block addresses, so the region size is turned into blocks.
+    discrete_t region = options.get( "ship-region" , 12 );
+    return std::make_unique<SHiP>( __specs.assoc , __specs.nsets ,
+                                   ( bits_t ) std::clamp< discrete_t >( options.get( "rrpv-bits" , 2 ) , 1 , 8 ) ,
+                                   ( bits_t ) ( region > __specs.bits.offset ? region - __specs.bits.offset : 0 ) ,
+                                   ( bits_t ) std::clamp< discrete_t >( options.get( "shct-bits" , 14 ) , 1 , 16 ) ,
+                                   options.has( "ship-bypass" ) );
+  }
   }
+  return nullptr;
 }
+
 Cache::~Cache() {
   cache.clear();
 }
 
 auto Cache::process([[maybe_unused]] addr_t addr) -> CacheAccess & {
+  return access( addr , nextEntry() );
+}
+
+auto Cache::access( addr_t addr , const TraceEntry &entry ) -> CacheAccess & {
+  program = entry.program;
+  arrival = entry.time;
+  return access( addr , entry.type );
+}
+
+auto Cache::access( addr_t addr , AccessType type ) -> CacheAccess & {
   __report.accesses++;
+  clock++;
+  __access.bypass = false;
   bool isFullBlock , isFull;
-  discrete_t index = 0;  
-  if( __specs.nsets > 1 ) {
-    index = ( addr >> ( __specs.bits.offset ) ) & ( ( 1 << __specs.bits.index ) - ( discrete_t ) 1);
-  } 
-  discrete_t tag = ( discrete_t ) addr >> ( __specs.bits.index + __specs.bits.offset );
+  __access.orig = addr;
+  discrete_t translation = tlb ? tlb.get()->Translate( addr ) : 0;
+  discrete_t writtenBack = __report.bytes_written_back;
+  discrete_t fetched = __report.bytes_fetched;
+  if( mapper ) {
+    addr = mapper.get()->Translate( addr );
+  }
+  discrete_t blockAddr = ( discrete_t ) addr >> __specs.bits.offset;
+  uint64_t sector = ( uint64_t ) 1 << ( ( addr >> sectorShift ) & sectorMask );
+  if( indexing.get()->Skewed() ) {
+    ProcessSkewed( blockAddr , sector , type );
+    Account( type , blockAddr , translation , writtenBack , fetched );
+    return this->__access;
+  }
+  discrete_t index = indexing.get()->Index( blockAddr , 0 );
+  discrete_t tag = indexing.get()->Tag( blockAddr );
   std::tuple search = IsInTheCache( index , tag );
   if( std::get<0>( search ) ) {
     __access.block = std::get<1>( search );
-    __access.res = AccessResult::HIT;
+    Touch( cache[index][__access.block] , sector , type );
     substitutionPolitics.get()->Refresh( index , std::get<1>( search ) );
-    __report.hits++;
   } else {
     __report.miss++;
-    isFullBlock = IsFullBlock( index );
-    isFull = IsFull();
-    __access.block = substitutionPolitics.get()->GetBlock( index );
+    __report.tag_misses++;
+    if( partition ) {
+      // A program only fills its own ways, the others do not count.
+      uint64_t ways = partition.get()->Ways( program );
+      isFullBlock = ( Invalid( index ) & ways ) == 0;
+      isFull = IsFull( ways );
+    } else {
+      isFullBlock = IsFullBlock( index );
+      isFull = IsFull();
+    }
     if( !isFullBlock ) {
-      for ( discrete_t i = 0; i < __specs.assoc ; i++ ) {
-        if( !cache[index][i].val ) {
-          __access.block = i;
-          break;
-        }
-      }
       __access.res = AccessResult::COMPULSORY_MISS;
       __report.compulsory_miss++;
+    } else if( isFull ) {
+      __access.res = AccessResult::CAPACITY_MISS;
+      __report.capacity_miss++;
     } else {
-      if( cache[index][__access.block].val && isFull ) {
-        __access.res = AccessResult::CAPACITY_MISS;
-        __report.capacity_miss++;
+      __access.res = AccessResult::CONFLICT_MISS;
+      __report.conflict_miss++;
+    }
+    Interference( tag * __specs.nsets + index );
+    substitutionPolitics.get()->Miss( index , tag );
+    __access.bypass = substitutionPolitics.get()->Bypass( index );
+    if( __access.bypass ) {
+      __report.bypasses++;
+      // Reads still come from memory, writes go straight to it.
+      if( type == AccessType::WRITE ) {
+        WriteBack( blockAddr , sectorBytes );
       } else {
-        __access.res = AccessResult::CONFLICT_MISS;
-        __report.conflict_miss++;
+        __report.bytes_fetched += sectorBytes;
       }
+    } else {
+      Fill( index , tag , isFullBlock , sector , type );
     }
-    cache[index][__access.block].val = true;
-    cache[index][__access.block].tag = tag;
   }
-  __access.orig = addr;
+  if( partition ) {
+    partition.get()->Access( index , tag , program , __access.res == AccessResult::HIT );
+  }
   // std::cout << __report.accesses << " " << __access.orig << " " << __access.block << " " << index << " " << "\n";
+  Account( type , blockAddr , translation , writtenBack , fetched );
   return this->__access;
 }
 
+// Skewed caches look at one set per way, so there is no set for the policy to
+// work on; the victim is the least recently used of the candidate lines.
+void Cache::ProcessSkewed( discrete_t blockAddr , uint64_t sector , AccessType type ) {
+  discrete_t victimSet = 0 , victimWay = 0;
+  bool invalid = false;
+  for ( discrete_t way = 0 ; way < __specs.assoc ; way++ ) {
+    discrete_t index = indexing.get()->Index( blockAddr , way );
+    CacheBlock &line = cache[index][way];
+    if( line.val && line.tag == blockAddr ) {
+      skewStamps[index * __specs.assoc + way] = ++skewClock;
+      __access.block = way;
+      Touch( line , sector , type );
+      return;
+    }
+    if( invalid ) {
+      continue;
+    }
+    if( !line.val ) {
+      invalid = true;
+      victimSet = index;
+      victimWay = way;
+    } else if( way == 0 || skewStamps[index * __specs.assoc + way] < skewStamps[victimSet * __specs.assoc + victimWay] ) {
+      victimSet = index;
+      victimWay = way;
+    }
+  }
+  __report.miss++;
+  __report.tag_misses++;
+  if( invalid ) {
+    __access.res = AccessResult::COMPULSORY_MISS;
+    __report.compulsory_miss++;
+    filled++;
+  } else if( IsFull() ) {
+    __access.res = AccessResult::CAPACITY_MISS;
+    __report.capacity_miss++;
+  } else {
+    __access.res = AccessResult::CONFLICT_MISS;
+    __report.conflict_miss++;
+  }
+  Interference( blockAddr );
+  if( cache[victimSet][victimWay].val ) {
+    __report.evictions++;
+    if( heatmap ) {
+      heatmap.get()->Evicted( victimSet );
+    }
+    if( lifetimes ) {
+      lifetimes.get()->Evict( victimSet * __specs.assoc + victimWay , clock );
+    }
+    Evicted( cache[victimSet][victimWay] , cache[victimSet][victimWay].tag );
+  }
+  Load( cache[victimSet][victimWay] , cache[victimSet][victimWay].tag , blockAddr , sector , type );
+  skewStamps[victimSet * __specs.assoc + victimWay] = ++skewClock;
+  __access.block = victimWay;
+}
+
+void Cache::Fill( discrete_t index , discrete_t tag , bool isFullBlock , uint64_t sector , AccessType type ) {
+  if( partition ) {
+    // A program only fills the ways of its partition, invalid ones first.
+    uint64_t ways = partition.get()->Ways( program );
+    uint64_t free = Invalid( index ) & ways;
+    __access.block = free ? ( discrete_t ) std::countr_zero( free ) : substitutionPolitics.get()->GetBlockIn( index , ways );
+  } else {
+    __access.block = substitutionPolitics.get()->GetBlock( index );
+    if( !isFullBlock ) {
+      // Ways are filled in order and never invalidated, so the fill count is
+      // the first invalid way.
+      __access.block = setFill[index];
+    }
+  }
+  if( !cache[index][__access.block].val ) {
+    setFill[index]++;
+    filled++;
+    wayFill[__access.block]++;
+  } else {
+    __report.evictions++;
+    if( heatmap ) {
+      heatmap.get()->Evicted( index );
+    }
+    if( lifetimes ) {
+      lifetimes.get()->Evict( index * __specs.assoc + __access.block , clock );
+    }
+    Evicted( cache[index][__access.block] , cache[index][__access.block].tag * __specs.nsets + index );
+    if ( blocks ) {
+      blocks->Erase( cache[index][__access.block].tag * __specs.nsets + index );
+    }
+  }
+  Load( cache[index][__access.block] , indexing.get()->Block( index , cache[index][__access.block].tag ) , tag , sector , type );
+  if ( blocks ) {
+    blocks->Insert( tag * __specs.nsets + index , ( uint32_t ) __access.block );
+  }
+  substitutionPolitics.get()->Insert( index , __access.block );
+}
+
+// The tag is present: a hit if the sector is too, otherwise only the sector is
+// fetched. A line another core invalidated is fetched again in place.
+void Cache::Touch( CacheBlock &line , uint64_t sector , AccessType type ) {
+  if( line.state == Coherence::INVALID ) {
+    __access.res = AccessResult::COHERENCE_MISS;
+    __report.miss++;
+    __report.coherence_misses++;
+    __report.bytes_fetched += sectorBytes;
+    line.sectors = sector;
+    line.state = Coherence::EXCLUSIVE;
+  } else if( line.sectors & sector ) {
+    __access.res = AccessResult::HIT;
+    __report.hits++;
+  } else {
+    __access.res = AccessResult::SECTOR_MISS;
+    __report.miss++;
+    __report.sector_misses++;
+    __report.bytes_fetched += sectorBytes;
+    line.sectors |= sector;
+  }
+  if( type == AccessType::WRITE ) {
+    line.dirty |= sector;
+    line.state = Coherence::MODIFIED;
+  }
+}
+
+// Puts the block that missed in `line`, writing back the dirty sectors of the
+// `victim` block it replaces. Only the accessed sector is fetched.
+void Cache::Load( CacheBlock &line , discrete_t victim , discrete_t tag , uint64_t sector , AccessType type ) {
+  if( line.val ) {
+    WriteBack( victim , ( discrete_t ) std::popcount( line.dirty ) * sectorBytes );
+  }
+  line.val = true;
+  line.tag = tag;
+  line.sectors = sector;
+  line.dirty = type == AccessType::WRITE ? sector : 0;
+  line.state = type == AccessType::WRITE ? Coherence::MODIFIED : Coherence::EXCLUSIVE;
+  line.owner = program;
+  __report.bytes_fetched += sectorBytes;
+}
+
+uint64_t Cache::Invalid( discrete_t index ) {
+  uint64_t invalid = 0;
+  for ( discrete_t way = 0 ; way < __specs.assoc ; way++ ) {
+    if( !cache[index][way].val ) {
+      invalid |= ( uint64_t ) 1 << way;
+    }
+  }
+  return invalid;
+}
+
+const Timing *Cache::Latencies() {
+  return timing.get();
+}
+
+Heatmap *Cache::Heat() {
+  return heatmap.get();
+}
+
+const Lifetimes *Cache::Lives() {
+  return lifetimes.get();
+}
+
+const WayPartition *Cache::Partition() {
+  return partition.get();
+}
+
+// Bookkeeping once the outcome of an access is known. `writtenBack` is the
+// byte count before the access, to tell whether it caused a writeback.
+// `fetched` likewise tells whether it read from memory.
+void Cache::Account( AccessType type , discrete_t blockAddr , discrete_t translation , discrete_t writtenBack , discrete_t fetched ) {
+  if( timing ) {
+    // The fetch goes first, memory serves reads before posted writes.
+    if( __report.bytes_fetched != fetched ) {
+      memory.insert( memory.begin() , { blockAddr , __report.bytes_fetched - fetched , false } );
+    }
+    timing.get()->Access( type , blockAddr , __access.res == AccessResult::HIT ,
+                          __report.bytes_written_back != writtenBack , translation , arrival , memory );
+    memory.clear();
+  }
+  if( heatmap || lifetimes ) {
+    // Skewed caches put the block in the set of the way it went to.
+    discrete_t index = indexing.get()->Index( blockAddr , indexing.get()->Skewed() ? __access.block : 0 );
+    if( heatmap ) {
+      heatmap.get()->Access( index , __access.orig , __access.res );
+    }
+    if( lifetimes && !__access.bypass ) {
+      // A block refetched after an invalidation starts a new generation, the
+      // old one was not evicted.
+      discrete_t line = index * __specs.assoc + __access.block;
+      if( __access.res == AccessResult::HIT || __access.res == AccessResult::SECTOR_MISS ) {
+        lifetimes.get()->Use( line , clock , __access.res == AccessResult::HIT );
+      } else {
+        lifetimes.get()->Fill( line , clock );
+      }
+    }
+  }
+  if( evictions.empty() ) {
+    return;
+  }
+  if( program >= programs.size() ) {
+    programs.resize( program + 1 );
+  }
+  programs[program].accesses++;
+  if( __access.res != AccessResult::HIT ) {
+    programs[program].miss++;
+  }
+}
+
+void Cache::WriteBack( discrete_t blockAddr , discrete_t bytes ) {
+  __report.bytes_written_back += bytes;
+  if( timing && bytes > 0 ) {
+    memory.push_back( { blockAddr , bytes , true } );
+  }
+}
+
+void Cache::Evicted( const CacheBlock &victim , discrete_t key ) {
+  if( evictions.empty() ) {
+    return;
+  }
+  evictions[( key * 0x9E3779B97F4A7C15ull ) >> evictionShift] = { key , victim.owner , program };
+}
+
+// A miss on a block of this program that another program pushed out.
+void Cache::Interference( discrete_t key ) {
+  if( evictions.empty() ) {
+    return;
+  }
+  Eviction &eviction = evictions[( key * 0x9E3779B97F4A7C15ull ) >> evictionShift];
+  if( eviction.key != key ) {
+    return;
+  }
+  if( eviction.owner == program && eviction.evictor != program ) {
+    if( program >= programs.size() ) {
+      programs.resize( program + 1 );
+    }
+    programs[program].interference++;
+  }
+  eviction = Eviction();
+}
+
+const std::vector< Cache::ProgramReport > &Cache::Programs() {
+  for ( ProgramReport &report : programs ) {
+    report.occupancy = 0;
+  }
+  for ( const std::vector< CacheBlock > &set : cache ) {
+    for ( const CacheBlock &line : set ) {
+      if( line.val && line.owner < programs.size() ) {
+        programs[line.owner].occupancy++;
+      }
+    }
+  }
+  return programs;
+}
+
+void Cache::SetMapper( std::shared_ptr< PageMapper > shared ) {
+  mapper = std::move( shared );
+}
+
+void Cache::SetMemory( std::shared_ptr< DRAM > shared , std::shared_ptr< Scheduler > clock ) {
+  if( timing ) {
+    timing.get()->SetMemory( std::move( shared ) , std::move( clock ) );
+  }
+}
+
+Cache::CacheBlock *Cache::Find( addr_t addr ) {
+  discrete_t blockAddr = ( discrete_t ) addr >> __specs.bits.offset;
+  if( indexing.get()->Skewed() ) {
+    for ( discrete_t way = 0 ; way < __specs.assoc ; way++ ) {
+      CacheBlock &line = cache[indexing.get()->Index( blockAddr , way )][way];
+      if( line.val && line.tag == blockAddr ) {
+        return &line;
+      }
+    }
+    return nullptr;
+  }
+  discrete_t index = indexing.get()->Index( blockAddr , 0 );
+  std::tuple search = IsInTheCache( index , indexing.get()->Tag( blockAddr ) );
+  return std::get<0>( search ) ? &cache[index][std::get<1>( search )] : nullptr;
+}
+
+Coherence Cache::State( addr_t addr ) {
+  CacheBlock *line = Find( addr );
+  return line ? line->state : Coherence::INVALID;
+}
+
+// Another core reads the block: dirty sectors go back to memory and the line
+// is kept as shared.
+void Cache::Downgrade( addr_t addr ) {
+  CacheBlock *line = Find( addr );
+  if( !line || line->state == Coherence::INVALID ) {
+    return;
+  }
+  WriteBack( ( discrete_t ) addr >> __specs.bits.offset , ( discrete_t ) std::popcount( line->dirty ) * sectorBytes );
+  line->dirty = 0;
+  line->state = Coherence::SHARED;
+}
+
+// Another core writes the block. Dirty data moves to the writer, so nothing is
+// written back.
+void Cache::Invalidate( addr_t addr ) {
+  CacheBlock *line = Find( addr );
+  if( !line ) {
+    return;
+  }
+  line->sectors = 0;
+  line->dirty = 0;
+  line->state = Coherence::INVALID;
+}
+
+// The lines stay, the new policy learns them as if they had just been filled
+// in way order.
+auto Cache::setPolicy( REPL repl , const Options &options ) -> void {
+  if( partition ) {
+    Partitionable( repl );
+  }
+  substitutionPolitics = MakePolicy( repl , options );
+  if( indexing.get()->Skewed() ) {
+    return;
+  }
+  for ( discrete_t index = 0 ; index < __specs.nsets ; index++ ) {
+    for ( discrete_t way = 0 ; way < __specs.assoc ; way++ ) {
+      if( cache[index][way].val ) {
+        substitutionPolitics.get()->Miss( index , cache[index][way].tag );
+        substitutionPolitics.get()->Insert( index , way );
+      }
+    }
+  }
+}
+
+auto Cache::finish() -> void {
+  if( timing ) {
+    timing.get()->Finish();
+  }
+}
+
+auto Cache::resetReport() -> void {
+  Backend::resetReport();
+  programs.clear();
+  if( heatmap ) {
+    heatmap.get()->Clear();
+  }
+  if( lifetimes ) {
+    lifetimes.get()->Clear();
+  }
+}
+
+auto Cache::serialize( Archive &archive ) -> void {
+  Backend::serialize( archive );
+  archive( cache )( setFill )( filled )( wayFill )( blocks )( skewStamps )( skewClock )( substitutionPolitics );
+  archive( tlb )( mapper )( partition )( timing )( memory )( programs )( evictions )( program )( arrival )( heatmap );
+  archive( lifetimes )( clock );
+}
+
 auto Cache::report() -> CacheReport & {
+  substitutionPolitics.get()->Report( __report );
+  if( tlb ) {
+    tlb.get()->Report( __report );
+  }
+  if( timing ) {
+    timing.get()->Report( __report );
+  }
+  if( lifetimes ) {
+    lifetimes.get()->Report( __report );
+  }
   __report.Calculate();
   return this->__report;
 }
 
 std::tuple< bool , discrete_t > Cache::IsInTheCache( discrete_t index , discrete_t tag ) {
+  if ( blocks ) {
+    uint32_t block = blocks->Find( tag * __specs.nsets + index );
+    return std::make_tuple( block != FlatMap::NONE , block == FlatMap::NONE ? 0 : block );
+  }
   for ( discrete_t block = 0 ; block < __specs.assoc ; block++ ) {
     if( ( tag == cache[index][block].tag ) && cache[index][block].val ) {
       return std::make_tuple( true , block );
@@ -87,23 +609,49 @@ std::tuple< bool , discrete_t > Cache::IsInTheCache( discrete_t index , discrete
 }
  
 bool Cache::IsFullBlock( discrete_t index ){
-  for ( discrete_t block = 0 ; block < __specs.assoc ; block++ ) {
-    if( !cache.at( index ).at( block ).val ) {
-      return false;
-    }
-  }
-  return true;
+  return setFill[index] == __specs.assoc;
 }
 
 bool Cache::IsFull(){
-  for( discrete_t index = 0 ; index < __specs.nsets ; index++ ) {
-    for ( discrete_t block = 0 ; block < __specs.assoc ; block++ ) {
-      if( !cache.at( index ).at( block ).val ) {
-        return false;
-      }
-    }
+  return filled == __specs.nsets * __specs.assoc;
+}
+
+// Whether every line of the ways in `ways` has been filled.
+bool Cache::IsFull( uint64_t ways ){
+  discrete_t lines = 0;
+  for ( uint64_t left = ways ; left != 0 ; left &= left - 1 ) {
+    lines += wayFill[std::countr_zero( left )];
+  }
+  return lines == __specs.nsets * ( discrete_t ) std::popcount( ways );
+}
+
+// Halts unless the policy can choose victims within a way mask.
+void Cache::Partitionable( REPL repl ) {
+  switch ( repl ) {
+  case REPL::LRU:
+  case REPL::RANDOM:
+  case REPL::SRRIP:
+  case REPL::BRRIP:
+  case REPL::DRRIP:
+  case REPL::DIP:
+  case REPL::NRU:
+  case REPL::LFU:
+    return;
+  default:
+    std::cout << "Way partitioning supports L, R, SRRIP, BRRIP, DRRIP, DIP, NRU and LFU\n\tHALTING PROGRAM\n";
+    exit(0);
+  }
+}
+
+RRIP::Insertion Cache::RRIPInsertion( REPL repl ) {
+  switch ( repl ) {
+  case REPL::BRRIP:
+    return RRIP::Insertion::BIMODAL;
+  case REPL::DRRIP:
+    return RRIP::Insertion::DYNAMIC;
+  default:
+    return RRIP::Insertion::STATIC;
   }
-  return true;
 }
 
 auto Cache::setCacheSpecs(std::span<std::string> command) -> CacheSpecs {
@@ -0,0 +1,59 @@
+#include "Backend/CountMinSketch.hpp"
+
+#include <bit>
+
+CountMinSketch::CountMinSketch( discrete_t width , discrete_t sample ) : sample( sample ) {
+    width = std::bit_ceil( width < 16 ? 16 : width );
+    widthMask = width - 1;
+    table = std::vector< uint64_t >( width * DEPTH / 16 , 0 );
+}
+
+CountMinSketch::~CountMinSketch() {
+    table.clear();
+}
+
+discrete_t CountMinSketch::Slot( discrete_t key , discrete_t row ) const {
+    // splitmix64 finalizer with a different seed per row.
+    discrete_t h = key + ( row + 1 ) * 0x9E3779B97F4A7C15ull;
+    h = ( h ^ ( h >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    h = ( h ^ ( h >> 27 ) ) * 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return row * ( widthMask + 1 ) + ( h & widthMask );
+}
+
+void CountMinSketch::Increment( discrete_t key ) {
+    for ( discrete_t row = 0 ; row < DEPTH ; row++ ) {
+        discrete_t slot = Slot( key , row );
+        uint64_t &word = table[slot / 16];
+        unsigned shift = ( unsigned ) ( slot % 16 ) * 4;
+        if ( ( ( word >> shift ) & 0xF ) != 0xF ) {
+            word += ( uint64_t ) 1 << shift;
+        }
+    }
+    if ( ++additions >= sample ) {
+        Reset();
+    }
+}
+
+uint8_t CountMinSketch::Estimate( discrete_t key ) const {
+    uint8_t estimate = 0xF;
+    for ( discrete_t row = 0 ; row < DEPTH ; row++ ) {
+        discrete_t slot = Slot( key , row );
+        uint8_t count = ( uint8_t ) ( ( table[slot / 16] >> ( ( slot % 16 ) * 4 ) ) & 0xF );
+        if ( count < estimate ) {
+            estimate = count;
+        }
+    }
+    return estimate;
+}
+
+void CountMinSketch::Reset() {
+    for ( uint64_t &word : table ) {
+        word = ( word >> 1 ) & 0x7777777777777777ull;
+    }
+    additions /= 2;
+}
+
+void CountMinSketch::Serialize( Archive &archive ) {
+    archive( table )( additions );
+}
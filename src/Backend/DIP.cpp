@@ -0,0 +1,52 @@
+#include "Backend/DIP.hpp"
+
+#include <bit>
+
+DIP::DIP( discrete_t associativity , discrete_t nstes , discrete_t throttle , discrete_t leaders , bits_t pselBits )
+    : SubstitutionPolitics( associativity ) , throttle( throttle ) , dueling( nstes , leaders , pselBits ) {
+    stamps = std::vector< discrete_t >( nstes * associativity , 0 );
+}
+
+DIP::~DIP() {
+    stamps.clear();
+}
+
+discrete_t DIP::GetBlock( discrete_t index ) {
+    const discrete_t *set = &stamps[index * associativity];
+    discrete_t victim = 0;
+    for ( discrete_t block = 1 ; block < associativity ; block++ ) {
+        if ( set[block] < set[victim] ) {
+            victim = block;
+        }
+    }
+    return victim;
+}
+
+discrete_t DIP::GetBlockIn( discrete_t index , uint64_t ways ) {
+    const discrete_t *set = &stamps[index * associativity];
+    discrete_t victim = ( discrete_t ) std::countr_zero( ways );
+    for ( discrete_t block = victim + 1 ; block < associativity ; block++ ) {
+        if ( ( ( ways >> block ) & 1 ) && set[block] < set[victim] ) {
+            victim = block;
+        }
+    }
+    return victim;
+}
+
+void DIP::Refresh( discrete_t index , discrete_t block ) {
+    stamps[index * associativity + block] = ++clock;
+}
+
+void DIP::Insert( discrete_t index , discrete_t block ) {
+    dueling.Miss( index );
+    // The filled way still holds the victim's stamp, the oldest in the set, so
+    // leaving it untouched is insertion at the LRU position.
+    if ( dueling.UseB( index ) && ( throttle == 0 || gen() % throttle != 0 ) ) {
+        return;
+    }
+    stamps[index * associativity + block] = ++clock;
+}
+
+void DIP::Serialize( Archive &archive ) {
+    archive( stamps )( clock )( dueling )( gen );
+}
@@ -0,0 +1,70 @@
+#include "Backend/DRAM.hpp"
+
+#include <algorithm>
+
+DRAM::DRAM( const Options &options , discrete_t blockBytes )
+    : channels( std::max< discrete_t >( options.get( "dram-channels" , 1 ) , 1 ) ) ,
+      ranks( std::max< discrete_t >( options.get( "dram-ranks" , 1 ) , 1 ) ) ,
+      banks( std::max< discrete_t >( options.get( "dram-banks" , 8 ) , 1 ) ) ,
+      blocksPerRow( std::max< discrete_t >( options.get( "dram-row" , 8192 ) / blockBytes , 1 ) ) ,
+      bytesPerCycle( std::max< discrete_t >( options.get( "dram-bandwidth" , 16 ) , 1 ) ) ,
+      cas( options.get( "dram-cl" , 40 ) ) , rcd( options.get( "dram-rcd" , 40 ) ) , rp( options.get( "dram-rp" , 40 ) ) {
+    state = std::vector< Bank >( channels * ranks * banks );
+    busFree = std::vector< discrete_t >( channels , 0 );
+}
+
+DRAM::~DRAM() {
+    state.clear();
+    busFree.clear();
+}
+
+discrete_t DRAM::Access( const MemoryRequest &request , discrete_t time ) {
+    discrete_t rest = request.block / blocksPerRow;
+    discrete_t channel = rest % channels;
+    rest /= channels;
+    discrete_t bank = rest % banks;
+    rest /= banks;
+    discrete_t rank = rest % ranks;
+    discrete_t row = rest / ranks;
+    Bank &target = state[( channel * ranks + rank ) * banks + bank];
+
+    discrete_t start = std::max( time , target.ready );
+    discrete_t command = cas;
+    if ( target.row == row ) {
+        rowHits++;
+    } else if ( target.row == CLOSED ) {
+        rowMisses++;
+        command += rcd;
+    } else {
+        rowConflicts++;
+        command += rp + rcd;
+    }
+    target.row = row;
+    target.ready = start + command;
+
+    discrete_t transfer = std::max< discrete_t >( ( request.bytes + bytesPerCycle - 1 ) / bytesPerCycle , 1 );
+    discrete_t data = std::max( start + command , busFree[channel] );
+    busFree[channel] = data + transfer;
+
+    discrete_t done = data + transfer;
+    requests++;
+    bytes += request.bytes;
+    latencies += done - time;
+    first = std::min( first , time );
+    last = std::max( last , done );
+    return done - time;
+}
+
+void DRAM::Report( CacheReport &report ) const {
+    report.dram_requests = requests;
+    report.dram_row_hits = rowHits;
+    report.dram_row_misses = rowMisses;
+    report.dram_row_conflicts = rowConflicts;
+    report.dram_bytes = bytes;
+    report.dram_latency_cycles = latencies;
+    report.dram_cycles = requests > 0 ? last - first : 0;
+}
+
+void DRAM::Serialize( Archive &archive ) {
+    archive( state )( busFree )( rowHits )( rowMisses )( rowConflicts )( requests )( bytes )( latencies )( first )( last );
+}
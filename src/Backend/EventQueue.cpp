@@ -0,0 +1,148 @@
+#include "Backend/EventQueue.hpp"
+
+#include <bit>
+
+EventQueue::EventQueue() {
+}
+
+EventQueue::~EventQueue() {
+    events.clear();
+}
+
+size_t EventQueue::BucketOf( discrete_t time ) const {
+    return ( size_t ) std::bit_width( time ^ now );
+}
+
+void EventQueue::Append( size_t bucket , uint32_t event ) {
+    events[event].next = NIL;
+    if ( buckets[bucket].tail == NIL ) {
+        buckets[bucket].head = event;
+    } else {
+        events[buckets[bucket].tail].next = event;
+    }
+    buckets[bucket].tail = event;
+}
+
+discrete_t EventQueue::Now() const {
+    return now;
+}
+
+bool EventQueue::Empty() const {
+    return pending == 0;
+}
+
+discrete_t EventQueue::Processed() const {
+    return processed;
+}
+
+uint32_t EventQueue::Insert( discrete_t time , Action action , void *context ) {
+    uint32_t event = freeList;
+    if ( event == NIL ) {
+        event = ( uint32_t ) events.size();
+        events.emplace_back();
+    } else {
+        freeList = events[event].next;
+    }
+    events[event].time = time < now ? now : time;
+    events[event].handler = NIL;
+    events[event].action = action;
+    events[event].context = context;
+    Append( BucketOf( events[event].time ) , event );
+    pending++;
+    return event;
+}
+
+void EventQueue::Schedule( discrete_t time , Action action , void *context ) {
+    Insert( time , action , context );
+}
+
+uint32_t EventQueue::Register( Action action , void *context ) {
+    handlers.push_back( { action , context } );
+    return ( uint32_t ) handlers.size() - 1;
+}
+
+void EventQueue::Schedule( discrete_t time , uint32_t handler ) {
+    events[Insert( time , handlers[handler].action , handlers[handler].context )].handler = handler;
+}
+
+void EventQueue::Schedule( discrete_t time , std::coroutine_handle<> handle ) {
+    Schedule( time , []( void *frame ) { std::coroutine_handle<>::from_address( frame ).resume(); } , handle.address() );
+}
+
+// Makes bucket 0 hold the earliest events, unless they are due after
+// `until`. When bucket 0 is empty the lowest non-empty bucket is split: its
+// earliest time becomes Now(), and its events, walked in order, land in lower
+// buckets in the same order.
+bool EventQueue::Advance( discrete_t until ) {
+    if ( buckets[0].head != NIL ) {
+        return now <= until;
+    }
+    size_t lowest = 1;
+    while ( buckets[lowest].head == NIL ) {
+        lowest++;
+    }
+    uint32_t event = buckets[lowest].head;
+    discrete_t earliest = events[event].time;
+    for ( ; event != NIL ; event = events[event].next ) {
+        earliest = events[event].time < earliest ? events[event].time : earliest;
+    }
+    if ( earliest > until ) {
+        return false;
+    }
+    now = earliest;
+    event = buckets[lowest].head;
+    buckets[lowest] = Bucket();
+    while ( event != NIL ) {
+        uint32_t next = events[event].next;
+        Append( BucketOf( events[event].time ) , event );
+        event = next;
+    }
+    return true;
+}
+
+bool EventQueue::RunNext( discrete_t until ) {
+    if ( pending == 0 || !Advance( until ) ) {
+        return false;
+    }
+    uint32_t event = buckets[0].head;
+    buckets[0].head = events[event].next;
+    if ( buckets[0].head == NIL ) {
+        buckets[0].tail = NIL;
+    }
+    // The slot is recycled before the action runs, which may schedule.
+    Action action = events[event].action;
+    void *context = events[event].context;
+    events[event].next = freeList;
+    freeList = event;
+    pending--;
+    processed++;
+    action( context );
+    return true;
+}
+
+discrete_t EventQueue::Run( discrete_t until ) {
+    while ( RunNext( until ) ) {
+    }
+    return now;
+}
+
+EventQueue::Wake EventQueue::At( discrete_t time ) {
+    return Wake{ *this , time };
+}
+
+EventQueue::Wake EventQueue::Delay( discrete_t cycles ) {
+    return Wake{ *this , now + cycles };
+}
+
+// Events are saved with their handler id, the pointers are this process's.
+void EventQueue::Serialize( Archive &archive ) {
+    archive( events )( buckets )( freeList )( now )( pending )( processed );
+    if ( !archive.saving() ) {
+        for ( Event &event : events ) {
+            if ( event.handler < handlers.size() ) {
+                event.action = handlers[event.handler].action;
+                event.context = handlers[event.handler].context;
+            }
+        }
+    }
+}
@@ -23,4 +23,6 @@ void FIFO::Refresh( [[maybe_unused]]  discrete_t index, [[maybe_unused]]discrete
     return;
 }
 
-
+void FIFO::Serialize(Archive &archive) {
+    archive(priority);
+}
@@ -0,0 +1,63 @@
+#include "Backend/FlatMap.hpp"
+
+#include <bit>
+
+FlatMap::FlatMap( discrete_t capacity ) {
+    // Keep the load factor at or below one half.
+    discrete_t size = std::bit_ceil( capacity * 2 < 2 ? 2 : capacity * 2 );
+    slots = std::vector< Slot >( size );
+    mask = size - 1;
+    shift = ( bits_t ) ( 64 - std::countr_zero( size ) );
+}
+
+FlatMap::~FlatMap() {
+    slots.clear();
+}
+
+discrete_t FlatMap::Home( discrete_t key ) const {
+    // Fibonacci hashing: the top bits of the product are well mixed.
+    return ( key * 0x9E3779B97F4A7C15ull ) >> shift;
+}
+
+uint32_t FlatMap::Find( discrete_t key ) const {
+    for ( discrete_t slot = Home( key ) ; slots[slot].key != EMPTY ; slot = ( slot + 1 ) & mask ) {
+        if ( slots[slot].key == key ) {
+            return slots[slot].value;
+        }
+    }
+    return NONE;
+}
+
+void FlatMap::Insert( discrete_t key , uint32_t value ) {
+    discrete_t slot = Home( key );
+    while ( slots[slot].key != EMPTY && slots[slot].key != key ) {
+        slot = ( slot + 1 ) & mask;
+    }
+    slots[slot].key = key;
+    slots[slot].value = value;
+}
+
+void FlatMap::Erase( discrete_t key ) {
+    discrete_t slot = Home( key );
+    while ( slots[slot].key != key ) {
+        if ( slots[slot].key == EMPTY ) {
+            return;
+        }
+        slot = ( slot + 1 ) & mask;
+    }
+    // Pull back every following entry whose home does not lie in the gap.
+    discrete_t next = ( slot + 1 ) & mask;
+    while ( slots[next].key != EMPTY ) {
+        discrete_t home = Home( slots[next].key );
+        if ( ( ( next - home ) & mask ) >= ( ( next - slot ) & mask ) ) {
+            slots[slot] = slots[next];
+            slot = next;
+        }
+        next = ( next + 1 ) & mask;
+    }
+    slots[slot] = Slot();
+}
+
+void FlatMap::Serialize( Archive &archive ) {
+    archive( slots );
+}
@@ -0,0 +1,90 @@
+#include "Backend/Heatmap.hpp"
+
+#include <algorithm>
+
+void Heatmap::Counters::Add( AccessResult result ) {
+    accesses++;
+    switch ( result ) {
+    case AccessResult::HIT:
+        hits++;
+        break;
+    case AccessResult::COMPULSORY_MISS:
+        compulsory++;
+        break;
+    case AccessResult::CAPACITY_MISS:
+        capacity++;
+        break;
+    case AccessResult::CONFLICT_MISS:
+        conflict++;
+        break;
+    case AccessResult::SECTOR_MISS:
+        sector++;
+        break;
+    case AccessResult::COHERENCE_MISS:
+        coherence++;
+        break;
+    default:
+        break;
+    }
+}
+
+void Heatmap::Counters::Merge( const Counters &other ) {
+    accesses += other.accesses;
+    hits += other.hits;
+    compulsory += other.compulsory;
+    capacity += other.capacity;
+    conflict += other.conflict;
+    sector += other.sector;
+    coherence += other.coherence;
+    evictions += other.evictions;
+}
+
+Heatmap::Heatmap( discrete_t nsets , bits_t regionBits ) : regionBits( regionBits ) {
+    sets = std::vector< Counters >( nsets );
+}
+
+Heatmap::~Heatmap() {
+    sets.clear();
+    regions.clear();
+}
+
+void Heatmap::Access( discrete_t set , addr_t addr , AccessResult result ) {
+    sets[set].Add( result );
+    regions[( discrete_t ) addr >> regionBits].Add( result );
+}
+
+void Heatmap::Evicted( discrete_t set ) {
+    sets[set].evictions++;
+}
+
+void Heatmap::Merge( const Heatmap &other ) {
+    for ( size_t set = 0 ; set < sets.size() && set < other.sets.size() ; set++ ) {
+        sets[set].Merge( other.sets[set] );
+    }
+    for ( const auto &[region , counters] : other.regions ) {
+        regions[region].Merge( counters );
+    }
+}
+
+void Heatmap::Clear() {
+    std::fill( sets.begin() , sets.end() , Counters() );
+    regions.clear();
+}
+
+const std::vector< Heatmap::Counters > &Heatmap::Sets() const {
+    return sets;
+}
+
+std::vector< std::pair< discrete_t , Heatmap::Counters > > Heatmap::Regions() const {
+    std::vector< std::pair< discrete_t , Counters > > sorted;
+    sorted.reserve( regions.size() );
+    for ( const auto &[region , counters] : regions ) {
+        sorted.emplace_back( region << regionBits , counters );
+    }
+    std::sort( sorted.begin() , sorted.end() , []( const auto &a , const auto &b ) { return a.first < b.first; } );
+    return sorted;
+}
+
+void Heatmap::Serialize( Archive &archive ) {
+    archive( sets )( regions );
+}
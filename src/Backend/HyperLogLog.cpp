@@ -0,0 +1,45 @@
+#include "Backend/HyperLogLog.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+HyperLogLog::HyperLogLog( bits_t precision ) : precision( precision ) {
+    registers = std::vector< uint8_t >( ( discrete_t ) 1 << precision , 0 );
+}
+
+HyperLogLog::~HyperLogLog() {
+    registers.clear();
+}
+
+void HyperLogLog::Add( discrete_t key ) {
+    // splitmix64 finalizer, block addresses are far from uniform.
+    discrete_t h = key + 0x9E3779B97F4A7C15ull;
+    h = ( h ^ ( h >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    h = ( h ^ ( h >> 27 ) ) * 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    // The top bits pick the register, the rest give the rank of the first one.
+    discrete_t rest = ( h << precision ) | ( ( discrete_t ) 1 << ( precision - 1 ) );
+    uint8_t rank = ( uint8_t ) ( std::countl_zero( rest ) + 1 );
+    uint8_t &slot = registers[h >> ( 64 - precision )];
+    slot = std::max( slot , rank );
+}
+
+discrete_t HyperLogLog::Estimate() const {
+    double m = ( double ) registers.size();
+    double sum = 0.0;
+    discrete_t zeros = 0;
+    for ( uint8_t rank : registers ) {
+        sum += std::ldexp( 1.0 , -rank );
+        zeros += rank == 0 ? 1 : 0;
+    }
+    double estimate = 0.7213 / ( 1.0 + 1.079 / m ) * m * m / sum;
+    if ( estimate <= 2.5 * m && zeros > 0 ) {
+        estimate = m * std::log( m / ( double ) zeros );
+    }
+    return ( discrete_t ) std::llround( estimate );
+}
+
+void HyperLogLog::Clear() {
+    std::fill( registers.begin() , registers.end() , 0 );
+}
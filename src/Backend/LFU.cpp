@@ -0,0 +1,63 @@
+#include "Backend/LFU.hpp"
+
+#include <bit>
+
+LFU::LFU( discrete_t associativity , discrete_t nstes , discrete_t aging ) : SubstitutionPolitics( associativity ) , aging( aging ) {
+    counts = std::vector< uint8_t >( nstes * associativity , 0 );
+    accesses = std::vector< discrete_t >( nstes , 0 );
+}
+
+LFU::~LFU() {
+    counts.clear();
+    accesses.clear();
+}
+
+discrete_t LFU::GetBlock( discrete_t index ) {
+    const uint8_t *set = &counts[index * associativity];
+    discrete_t victim = 0;
+    for ( discrete_t block = 1 ; block < associativity && set[victim] > 0 ; block++ ) {
+        if ( set[block] < set[victim] ) {
+            victim = block;
+        }
+    }
+    return victim;
+}
+
+discrete_t LFU::GetBlockIn( discrete_t index , uint64_t ways ) {
+    const uint8_t *set = &counts[index * associativity];
+    discrete_t victim = ( discrete_t ) std::countr_zero( ways );
+    for ( discrete_t block = victim + 1 ; block < associativity && set[victim] > 0 ; block++ ) {
+        if ( ( ( ways >> block ) & 1 ) && set[block] < set[victim] ) {
+            victim = block;
+        }
+    }
+    return victim;
+}
+
+void LFU::Refresh( discrete_t index , discrete_t block ) {
+    uint8_t &count = counts[index * associativity + block];
+    if ( count < UINT8_MAX ) {
+        count++;
+    }
+    Access( index );
+}
+
+void LFU::Insert( discrete_t index , discrete_t block ) {
+    counts[index * associativity + block] = 1;
+    Access( index );
+}
+
+void LFU::Access( discrete_t index ) {
+    if ( aging == 0 || ++accesses[index] < aging ) {
+        return;
+    }
+    accesses[index] = 0;
+    uint8_t *set = &counts[index * associativity];
+    for ( discrete_t block = 0 ; block < associativity ; block++ ) {
+        set[block] = ( uint8_t ) ( set[block] >> 1 );
+    }
+}
+
+void LFU::Serialize( Archive &archive ) {
+    archive( counts )( accesses );
+}
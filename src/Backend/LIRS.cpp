@@ -0,0 +1,123 @@
+#include "Backend/LIRS.hpp"
+
+#include <algorithm>
+
+LIRS::LIRS( discrete_t associativity , discrete_t nstes , discrete_t hirPercent )
+    : DirectoryPolitics( associativity , nstes , 2 * associativity + 1 ) {
+    discrete_t hir = std::clamp< discrete_t >( associativity * hirPercent / 100 , 1 , associativity );
+    lirLimit = associativity - hir;
+    sets = std::vector< Set >( nstes );
+}
+
+LIRS::~LIRS() {
+    sets.clear();
+}
+
+// Pops HIR entries off the bottom of the stack so the bottom is always LIR.
+void LIRS::Prune( Set &set ) {
+    while ( !set.stack.Empty() && nodes[set.stack.Back()].state != LIR ) {
+        uint32_t node = set.stack.Back();
+        set.stack.Remove( nodes , node );
+        nodes[node].inStack = false;
+        if ( nodes[node].state == NONRESIDENT ) {
+            set.ghosts.Remove( nodes , node );
+            Release( node );
+        }
+    }
+}
+
+// Turns the bottom LIR block into a resident HIR one.
+void LIRS::Demote( Set &set ) {
+    Prune( set );
+    uint32_t node = set.stack.Back();
+    set.stack.Remove( nodes , node );
+    nodes[node].inStack = false;
+    nodes[node].state = HIR;
+    set.queue.PushFront( nodes , node );
+    set.lir--;
+    Prune( set );
+}
+
+discrete_t LIRS::GetBlock( discrete_t index ) {
+    Set &set = sets[index];
+    if ( set.lir + set.queue.size < associativity ) {
+        return 0; // The set still has invalid ways, the cache fills one of those.
+    }
+    if ( set.queue.Empty() ) {
+        Demote( set );
+    }
+    uint32_t victim = set.queue.Back();
+    set.queue.Remove( nodes , victim );
+    if ( !nodes[victim].inStack ) {
+        Release( victim );
+        return nodes[victim].way; // Released nodes keep their contents until reused.
+    }
+    nodes[victim].state = NONRESIDENT;
+    set.ghosts.PushFront( nodes , victim );
+    if ( set.ghosts.size > associativity ) {
+        uint32_t ghost = set.ghosts.Back();
+        set.ghosts.Remove( nodes , ghost );
+        set.stack.Remove( nodes , ghost );
+        Release( ghost );
+        if ( ghost == pendingNode ) {
+            pendingNode = NONE;
+        }
+    }
+    return nodes[victim].way;
+}
+
+void LIRS::Refresh( discrete_t index , discrete_t block ) {
+    Set &set = sets[index];
+    uint32_t node = NodeAt( index , block );
+    LIRSNode &n = nodes[node];
+    if ( n.state == LIR ) {
+        set.stack.MoveToFront( nodes , node );
+        Prune( set );
+    } else if ( n.inStack ) {
+        set.stack.MoveToFront( nodes , node );
+        set.queue.Remove( nodes , node );
+        n.state = LIR;
+        set.lir++;
+        if ( set.lir > lirLimit ) {
+            Demote( set );
+        }
+    } else {
+        set.stack.PushFront( nodes , node );
+        n.inStack = true;
+        set.queue.MoveToFront( nodes , node );
+    }
+}
+
+void LIRS::Insert( discrete_t index , discrete_t block ) {
+    Set &set = sets[index];
+    uint32_t node = pendingNode;
+    if ( node != NONE ) {
+        // A non-resident HIR block still in the stack was reused within the
+        // LIR recency, so it comes back as LIR.
+        set.ghosts.Remove( nodes , node );
+        set.stack.MoveToFront( nodes , node );
+        nodes[node].state = LIR;
+        set.lir++;
+        if ( set.lir > lirLimit ) {
+            Demote( set );
+        }
+    } else {
+        node = Allocate( pendingKey );
+        set.stack.PushFront( nodes , node );
+        nodes[node].inStack = true;
+        if ( set.lir < lirLimit ) {
+            nodes[node].state = LIR;
+            set.lir++;
+        } else {
+            nodes[node].state = HIR;
+            set.queue.PushFront( nodes , node );
+        }
+    }
+    Place( index , block , node );
+    pendingNode = NONE;
+}
+
+void LIRS::Serialize( Archive &archive ) {
+    DirectoryPolitics::Serialize( archive );
+    archive( sets );
+}
@@ -19,9 +19,23 @@ discrete_t LRU::GetBlock( discrete_t index ) {
     priority[index].push_back( temp );
     return temp;
 }
+discrete_t LRU::GetBlockIn( discrete_t index , uint64_t ways ) {
+    for ( auto it = priority[index].begin() ; it != priority[index].end() ; it++ ) {
+        if ( ( ways >> *it ) & 1 ) {
+            discrete_t temp = *it;
+            priority[index].erase( it );
+            priority[index].push_back( temp );
+            return temp;
+        }
+    }
+    return GetBlock( index );
+}
+
 void LRU::Refresh(discrete_t index, discrete_t block) { 
     priority[index].remove( block );
     priority[index].push_back( block );
 }
 
-
+void LRU::Serialize(Archive &archive) {
+    archive(priority);
+}
@@ -0,0 +1,87 @@
+#include "Backend/Lifetimes.hpp"
+
+#include <algorithm>
+#include <bit>
+
+Lifetimes::Lifetimes( discrete_t lines ) {
+    this->lines = std::vector< Line >( lines );
+}
+
+Lifetimes::~Lifetimes() {
+    lines.clear();
+}
+
+discrete_t Lifetimes::From( discrete_t bucket ) {
+    return bucket == 0 ? 0 : ( discrete_t ) 1 << ( bucket - 1 );
+}
+
+void Lifetimes::Add( Histogram &histogram , discrete_t value ) {
+    histogram[std::min< discrete_t >( ( discrete_t ) std::bit_width( value ) , BUCKETS - 1 )]++;
+}
+
+void Lifetimes::Fill( discrete_t line , discrete_t now ) {
+    lines[line] = { now , now , 0 };
+}
+
+void Lifetimes::Use( discrete_t line , discrete_t now , bool hit ) {
+    lines[line].used = now;
+    if ( hit ) {
+        lines[line].hits++;
+    }
+}
+
+void Lifetimes::Evict( discrete_t line , discrete_t now ) {
+    const Line &block = lines[line];
+    Add( live , block.used - block.filled );
+    Add( dead , now - block.used );
+    Add( hits , block.hits );
+    evicted++;
+    neverHit += block.hits == 0 ? 1 : 0;
+    liveTime += block.used - block.filled;
+    deadTime += now - block.used;
+}
+
+void Lifetimes::Merge( const Lifetimes &other ) {
+    for ( discrete_t bucket = 0 ; bucket < BUCKETS ; bucket++ ) {
+        live[bucket] += other.live[bucket];
+        dead[bucket] += other.dead[bucket];
+        hits[bucket] += other.hits[bucket];
+    }
+    evicted += other.evicted;
+    neverHit += other.neverHit;
+    liveTime += other.liveTime;
+    deadTime += other.deadTime;
+}
+
+void Lifetimes::Clear() {
+    live = {};
+    dead = {};
+    hits = {};
+    evicted = 0;
+    neverHit = 0;
+    liveTime = 0;
+    deadTime = 0;
+}
+
+void Lifetimes::Report( CacheReport &report ) const {
+    report.lifetime_evictions = evicted;
+    report.never_hit_evictions = neverHit;
+    report.live_time = liveTime;
+    report.dead_time = deadTime;
+}
+
+const Lifetimes::Histogram &Lifetimes::Live() const {
+    return live;
+}
+
+const Lifetimes::Histogram &Lifetimes::Dead() const {
+    return dead;
+}
+
+const Lifetimes::Histogram &Lifetimes::Hits() const {
+    return hits;
+}
+
+void Lifetimes::Serialize( Archive &archive ) {
+    archive( lines )( live )( dead )( hits )( evicted )( neverHit )( liveTime )( deadTime );
+}
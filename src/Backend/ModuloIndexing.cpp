@@ -0,0 +1,34 @@
+#include "Backend/ModuloIndexing.hpp"
+
+#include <bit>
+
+__extension__ typedef unsigned __int128 uint128_t;
+
+ModuloIndexing::ModuloIndexing( discrete_t nsets ) : Indexing( nsets ) {
+    pow2 = std::has_single_bit( nsets );
+    shift = ( bits_t ) std::countr_zero( nsets );
+    reciprocal = UINT64_MAX / nsets + 1;
+}
+
+ModuloIndexing::~ModuloIndexing() {
+}
+
+// Both fastmod and fastdiv are exact for 32-bit block addresses.
+discrete_t ModuloIndexing::Index( discrete_t block , [[maybe_unused]] discrete_t way ) const {
+    if ( pow2 ) {
+        return block & ( nsets - 1 );
+    }
+    uint64_t low = reciprocal * block;
+    return ( discrete_t ) ( ( ( uint128_t ) low * nsets ) >> 64 );
+}
+
+discrete_t ModuloIndexing::Tag( discrete_t block ) const {
+    if ( pow2 ) {
+        return block >> shift;
+    }
+    return ( discrete_t ) ( ( ( uint128_t ) reciprocal * block ) >> 64 );
+}
+
+discrete_t ModuloIndexing::Block( discrete_t index , discrete_t tag ) const {
+    return tag * nsets + index;
+}
@@ -0,0 +1,254 @@
+#include "Backend/MultiCore.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+MultiCore::MultiCore( std::span< std::string > command , const Options &options )
+    : Backend( CacheSpecs( 32 , std::stoull( command[0] ) , std::stoull( command[1] ) , std::stoull( command[2] ) , command[3] ) ) {
+  discrete_t count = options.get( "cores" , 1 );
+  if ( count == 0 || count > 65536 ) {
+    std::cout << "The number of cores must be between 1 and 65536\n\tHALTING PROGRAM\n";
+    exit(0);
+  }
+  Options local = options;
+  local.erase( "mapping" );
+  if ( options.has( "mapping" ) ) {
+    mapper = std::make_shared<PageMapper>( PageMapper::Kind( options.get( "mapping" , "identity" ) ) , options ,
+                                           __specs.nsets * __specs.block * __specs.assoc , __specs.assoc );
+  }
+  if ( options.has( "dram" ) ) {
+    if ( options.get( "threads" , 1 ) > 1 ) {
+      std::cout << "The DRAM model does not run with --threads\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    dram = std::make_shared<DRAM>( options , __specs.block );
+    scheduler = std::make_shared<Scheduler>();
+  }
+  cores = std::vector< std::unique_ptr< Cache > >( count );
+  for ( discrete_t core = 0 ; core < count ; core++ ) {
+    cores[core] = std::make_unique<Cache>( command , local );
+    if ( mapper ) {
+      cores[core].get()->SetMapper( mapper );
+    }
+    if ( dram ) {
+      cores[core].get()->SetMemory( dram , scheduler );
+    }
+  }
+  traffic = std::vector< Traffic >( count );
+  if ( options.has( "sharing" ) ) {
+    profiler = std::make_unique<SharingProfiler>( __specs.bits.offset , options.get( "access-size" , 4 ) );
+  }
+  discrete_t threads = std::min( options.get( "threads" , 1 ) , count );
+  if ( threads > 1 ) {
+    // Longer quanta apply snoops late and change the results, so they are
+    // only taken when asked for.
+    quantum = std::max< discrete_t >( options.get( "quantum" , 1 ) , 1 );
+    pending = std::vector< std::vector< Pending > >( count );
+    steps = std::vector< Step >( quantum );
+    start = std::make_unique< std::barrier<> >( ( std::ptrdiff_t ) threads + 1 );
+    done = std::make_unique< std::barrier<> >( ( std::ptrdiff_t ) threads + 1 );
+    for ( discrete_t worker = 0 ; worker < threads ; worker++ ) {
+      workers.emplace_back( &MultiCore::Work , this , worker );
+    }
+  }
+}
+
+MultiCore::~MultiCore() {
+  if ( !workers.empty() ) {
+    stopping = true;
+    start.get()->arrive_and_wait();
+    for ( std::thread &worker : workers ) {
+      worker.join();
+    }
+  }
+  cores.clear();
+}
+
+auto MultiCore::process([[maybe_unused]] addr_t addr) -> CacheAccess & {
+  TraceEntry entry = nextEntry();
+  discrete_t core = entry.core % cores.size();
+  addr_t phys = mapper ? mapper.get()->Translate( addr ) : addr;
+  if ( !workers.empty() ) {
+    // The outcome is only known once the quantum has run.
+    pending[core].push_back( { addr , phys , buffered++ , entry } );
+    if ( buffered == quantum ) {
+      RunQuantum();
+    }
+    __access = CacheAccess();
+    __access.orig = addr;
+    return __access;
+  }
+  bool shared = Snoop( core , phys , entry.type , cores[core].get()->State( phys ) );
+  __access = cores[core].get()->access( addr , entry );
+  if ( shared ) {
+    cores[core].get()->Downgrade( phys );
+  }
+  if ( profiler ) {
+    profiler.get()->Access( phys , core , entry.type , __access.res == AccessResult::COHERENCE_MISS );
+  }
+  return __access;
+}
+
+bool MultiCore::NeedsBus( AccessType type , Coherence state ) {
+  if ( type == AccessType::WRITE ) {
+    return state == Coherence::SHARED || state == Coherence::INVALID;
+  }
+  return state == Coherence::INVALID;
+}
+
+// Runs the bus transaction, if any, of `core` accessing `phys` from `state`.
+// Returns whether a read found other copies, in which case the requester's
+// line must end up shared.
+bool MultiCore::Snoop( discrete_t core , addr_t phys , AccessType type , Coherence state ) {
+  if ( !NeedsBus( type , state ) ) {
+    return false;
+  }
+  // BusUpgr from a shared line, BusRdX from an invalid one, BusRd for reads;
+  // a modified copy is supplied by its owner.
+  if ( type == AccessType::WRITE && state == Coherence::SHARED ) {
+    traffic[core].upgrades++;
+  }
+  bool shared = false;
+  for ( discrete_t other = 0 ; other < cores.size() ; other++ ) {
+    Coherence theirs = other == core ? Coherence::INVALID : cores[other].get()->State( phys );
+    if ( theirs == Coherence::INVALID ) {
+      continue;
+    }
+    if ( theirs == Coherence::MODIFIED ) {
+      traffic[core].interventions++;
+    }
+    if ( type == AccessType::WRITE ) {
+      cores[other].get()->Invalidate( phys );
+      traffic[core].invalidations++;
+      if ( profiler ) {
+        profiler.get()->Invalidate( phys , other );
+      }
+    } else {
+      cores[other].get()->Downgrade( phys );
+      shared = true;
+    }
+  }
+  return shared;
+}
+
+void MultiCore::Work( discrete_t worker ) {
+  while ( true ) {
+    start.get()->arrive_and_wait();
+    if ( stopping ) {
+      return;
+    }
+    for ( discrete_t core = worker ; core < cores.size() ; core += workers.size() ) {
+      Cache &cache = *cores[core].get();
+      for ( const Pending &access : pending[core] ) {
+        Coherence state = cache.State( access.phys );
+        AccessType type = access.entry.type;
+        bool miss = cache.access( access.addr , access.entry ).res == AccessResult::COHERENCE_MISS;
+        steps[access.seq] = { NeedsBus( type , state ) , miss , type , state , ( uint16_t ) core , access.phys };
+      }
+    }
+    done.get()->arrive_and_wait();
+  }
+}
+
+// Lets every worker run its cores through the buffered accesses, then applies
+// their bus transactions and profiling in trace order. Snoops arrive up to a
+// quantum late, --quantum=1 gives the same results as the serial engine.
+void MultiCore::RunQuantum() {
+  if ( buffered == 0 ) {
+    return;
+  }
+  start.get()->arrive_and_wait();
+  done.get()->arrive_and_wait();
+  for ( discrete_t seq = 0 ; seq < buffered ; seq++ ) {
+    const Step &step = steps[seq];
+    if ( step.bus && Snoop( step.core , step.phys , step.type , step.state ) ) {
+      cores[step.core].get()->Downgrade( step.phys );
+    }
+    if ( profiler ) {
+      profiler.get()->Access( step.phys , step.core , step.type , step.coherenceMiss );
+    }
+  }
+  for ( std::vector< Pending > &accesses : pending ) {
+    accesses.clear();
+  }
+  buffered = 0;
+}
+
+SharingProfiler *MultiCore::Profiler() {
+  return profiler.get();
+}
+
+discrete_t MultiCore::Cores() {
+  return cores.size();
+}
+
+Cache &MultiCore::Core( discrete_t core ) {
+  return *cores[core].get();
+}
+
+CacheReport &MultiCore::CoreReport( discrete_t core ) {
+  CacheReport &report = cores[core].get()->report();
+  report.invalidations = traffic[core].invalidations;
+  report.upgrades = traffic[core].upgrades;
+  report.interventions = traffic[core].interventions;
+  return report;
+}
+
+auto MultiCore::setPolicy( REPL repl , const Options &options ) -> void {
+  for ( std::unique_ptr< Cache > &core : cores ) {
+    core.get()->setPolicy( repl , options );
+  }
+}
+
+auto MultiCore::drain() -> void {
+  if ( !workers.empty() ) {
+    RunQuantum();
+  }
+}
+
+auto MultiCore::settled() -> bool {
+  return buffered == 0;
+}
+
+auto MultiCore::finish() -> void {
+  drain();
+  for ( std::unique_ptr< Cache > &core : cores ) {
+    core.get()->finish();
+  }
+}
+
+auto MultiCore::resetReport() -> void {
+  drain();
+  Backend::resetReport();
+  for ( std::unique_ptr< Cache > &core : cores ) {
+    core.get()->resetReport();
+  }
+  traffic = std::vector< Traffic >( cores.size() );
+}
+
+// Buffered accesses are saved as they are: a forked checkpoint writer has no
+// workers, so saving must never run a quantum.
+auto MultiCore::serialize( Archive &archive ) -> void {
+  Backend::serialize( archive );
+  archive( cores )( traffic )( profiler )( pending )( buffered );
+}
+
+auto MultiCore::report() -> CacheReport & {
+  if ( !workers.empty() ) {
+    RunQuantum();
+  }
+  __report = CacheReport();
+  for ( discrete_t core = 0 ; core < cores.size() ; core++ ) {
+    __report.Accumulate( CoreReport( core ) );
+  }
+  if ( profiler ) {
+    __report.true_sharing_misses = profiler.get()->TrueSharing();
+    __report.false_sharing_misses = profiler.get()->FalseSharing();
+  }
+  if ( dram ) {
+    dram.get()->Report( __report );
+  }
+  __report.Calculate();
+  return __report;
+}
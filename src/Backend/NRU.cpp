@@ -0,0 +1,47 @@
+#include "Backend/NRU.hpp"
+
+#include <bit>
+
+NRU::NRU( discrete_t associativity , discrete_t nstes ) : SubstitutionPolitics( associativity ) {
+    used = std::vector< uint64_t >( nstes , 0 );
+    full = associativity >= 64 ? ~( uint64_t ) 0 : ( ( uint64_t ) 1 << associativity ) - 1;
+}
+
+NRU::~NRU() {
+    used.clear();
+}
+
+discrete_t NRU::GetBlock( discrete_t index ) {
+    // Touch never leaves every bit set, except in a direct-mapped set where
+    // way 0 is the only choice anyway.
+    const uint64_t clear = ~used[index] & full;
+    return clear ? ( discrete_t ) std::countr_zero( clear ) : 0;
+}
+
+discrete_t NRU::GetBlockIn( discrete_t index , uint64_t ways ) {
+    const uint64_t clear = ~used[index] & ways;
+    if ( clear ) {
+        return ( discrete_t ) std::countr_zero( clear );
+    }
+    // Every way of the partition was used: start a new round inside it.
+    used[index] &= ~ways;
+    return ( discrete_t ) std::countr_zero( ways );
+}
+
+void NRU::Refresh( discrete_t index , discrete_t block ) {
+    Touch( index , block );
+}
+
+void NRU::Insert( discrete_t index , discrete_t block ) {
+    Touch( index , block );
+}
+
+void NRU::Touch( discrete_t index , discrete_t block ) {
+    const uint64_t bit = ( uint64_t ) 1 << block;
+    uint64_t word = used[index] | bit;
+    used[index] = word == full ? bit : word;
+}
+
+void NRU::Serialize( Archive &archive ) {
+    archive( used );
+}
@@ -0,0 +1,44 @@
+#include "Backend/PLRU.hpp"
+
+PLRU::PLRU( discrete_t associativity , discrete_t nstes ) : SubstitutionPolitics( associativity ) {
+    trees = std::vector< uint64_t >( nstes , 0 );
+}
+
+PLRU::~PLRU() {
+    trees.clear();
+}
+
+discrete_t PLRU::GetBlock( discrete_t index ) {
+    const uint64_t tree = trees[index];
+    discrete_t node = 1;
+    while ( node < associativity ) {
+        node = 2 * node + ( ( tree >> ( node - 1 ) ) & 1 );
+    }
+    return node - associativity;
+}
+
+void PLRU::Refresh( discrete_t index , discrete_t block ) {
+    Touch( index , block );
+}
+
+void PLRU::Insert( discrete_t index , discrete_t block ) {
+    Touch( index , block );
+}
+
+void PLRU::Touch( discrete_t index , discrete_t block ) {
+    uint64_t tree = trees[index];
+    for ( discrete_t node = block + associativity ; node > 1 ; node /= 2 ) {
+        // Point the parent at the sibling of the path we just came up.
+        const uint64_t bit = ( uint64_t ) 1 << ( node / 2 - 1 );
+        if ( node & 1 ) {
+            tree &= ~bit;
+        } else {
+            tree |= bit;
+        }
+    }
+    trees[index] = tree;
+}
+
+void PLRU::Serialize( Archive &archive ) {
+    archive( trees );
+}
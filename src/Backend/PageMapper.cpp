@@ -0,0 +1,100 @@
+#include "Backend/PageMapper.hpp"
+#include "Backend/TLB.hpp"
+
+#include <bit>
+#include <iostream>
+#include <utility>
+
+PageMapper::PageMapper( Allocator allocator , const Options &options , discrete_t cacheBytes , discrete_t assoc )
+    : allocator( allocator ) , gen( options.get( "seed" , 1 ) ) {
+    discrete_t pageSize = TLB::PageSize( options );
+    pageBits = ( bits_t ) std::countr_zero( pageSize );
+    if ( allocator == Allocator::HUGE && pageBits < HUGE_PAGE_BITS ) {
+        pageBits = HUGE_PAGE_BITS;
+    }
+    // Physical memory in MiB, 4 GiB by default which is all a 32-bit address reaches.
+    discrete_t memory = options.get( "phys-mem" , 4096 ) << 20;
+    if ( memory > ( ( discrete_t ) 1 << 32 ) ) {
+        memory = ( discrete_t ) 1 << 32;
+    }
+    frames = memory >> pageBits;
+    discrete_t pages = ( ( discrete_t ) 1 << ( 32 - pageBits ) );
+    table = std::vector< std::vector< uint32_t > >( ( pages + ( 1 << LEAF_BITS ) - 1 ) >> LEAF_BITS );
+    switch ( allocator ) {
+    case Allocator::RANDOM:
+    case Allocator::HUGE:
+        freeFrames = std::vector< uint32_t >( frames );
+        for ( discrete_t frame = 0 ; frame < frames ; frame++ ) {
+            freeFrames[frame] = ( uint32_t ) frame;
+        }
+        break;
+    case Allocator::COLOR: {
+        // Pages of one color map to the same cache sets in every way.
+        discrete_t colors = ( cacheBytes / assoc ) >> pageBits;
+        nextOfColor = std::vector< discrete_t >( colors == 0 ? 1 : colors , 0 );
+        break;
+    }
+    case Allocator::IDENTITY:
+        break;
+    }
+}
+
+PageMapper::~PageMapper() {
+    table.clear();
+}
+
+PageMapper::Allocator PageMapper::Kind( const std::string &name ) {
+    if ( name == "random" ) {
+        return Allocator::RANDOM;
+    } else if ( name == "color" ) {
+        return Allocator::COLOR;
+    } else if ( name == "huge" ) {
+        return Allocator::HUGE;
+    } else if ( name != "identity" ) {
+        std::cout << "--mapping is identity, random, color or huge\n\tHALTING PROGRAM\n";
+        exit(0);
+    }
+    return Allocator::IDENTITY;
+}
+
+addr_t PageMapper::Translate( addr_t addr ) {
+    if ( allocator == Allocator::IDENTITY ) {
+        return addr;
+    }
+    discrete_t page = ( discrete_t ) addr >> pageBits;
+    std::vector< uint32_t > &leaf = table[page >> LEAF_BITS];
+    if ( leaf.empty() ) {
+        leaf = std::vector< uint32_t >( ( size_t ) 1 << LEAF_BITS , 0 );
+    }
+    uint32_t &entry = leaf[page & ( ( 1 << LEAF_BITS ) - 1 )];
+    if ( entry == 0 ) {
+        entry = Allocate( page ) + 1;
+    }
+    discrete_t offset = addr & ( ( ( discrete_t ) 1 << pageBits ) - 1 );
+    return ( addr_t ) ( ( ( discrete_t ) ( entry - 1 ) << pageBits ) | offset );
+}
+
+uint32_t PageMapper::Allocate( discrete_t page ) {
+    if ( allocator == Allocator::COLOR ) {
+        discrete_t colors = nextOfColor.size();
+        discrete_t color = page % colors;
+        discrete_t frame = color + colors * nextOfColor[color]++;
+        if ( frame >= frames ) {
+            std::cout << "Out of physical frames of color " << color << "\n\tHALTING PROGRAM\n";
+            exit(0);
+        }
+        return ( uint32_t ) frame;
+    }
+    if ( nextFree == frames ) {
+        std::cout << "Out of physical frames\n\tHALTING PROGRAM\n";
+        exit(0);
+    }
+    // One step of a Fisher-Yates shuffle: a uniformly random free frame.
+    std::uniform_int_distribution< discrete_t > dist( nextFree , frames - 1 );
+    std::swap( freeFrames[nextFree] , freeFrames[dist( gen )] );
+    return freeFrames[nextFree++];
+}
+
+void PageMapper::Serialize( Archive &archive ) {
+    archive( table )( freeFrames )( nextFree )( nextOfColor )( gen );
+}
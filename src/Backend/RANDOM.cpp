@@ -1,22 +1,32 @@
 #include "Backend/RANDOM.hpp"
 
+#include <bit>
 #include <random>
 
-RANDOM::RANDOM( discrete_t associativity , [[maybe_unused]] discrete_t nstes ) : SubstitutionPolitics( associativity) {
+RANDOM::RANDOM( discrete_t associativity , [[maybe_unused]] discrete_t nstes , discrete_t seed ) : SubstitutionPolitics( associativity) , gen( seed ) {
 }
 
 RANDOM::~RANDOM() {       
 }
 
 discrete_t RANDOM::GetBlock( [[maybe_unused]] discrete_t index ) {
-    static std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<> dist( 0 , ( int ) ( this->associativity - 1 ) );
     return ( discrete_t ) dist(gen);
 
 } 
 
+discrete_t RANDOM::GetBlockIn( [[maybe_unused]] discrete_t index , uint64_t ways ) {
+    std::uniform_int_distribution<> dist( 0 , std::popcount( ways ) - 1 );
+    for ( int skip = dist( gen ) ; skip > 0 ; skip-- ) {
+        ways &= ways - 1;
+    }
+    return ( discrete_t ) std::countr_zero( ways );
+}
+
 void RANDOM::Refresh( [[maybe_unused]] discrete_t index, [[maybe_unused]] discrete_t block) {
     return;
 }
 
-
+void RANDOM::Serialize( Archive &archive ) {
+    archive( gen );
+}
@@ -0,0 +1,96 @@
+#include "Backend/RRIP.hpp"
+
+#include <bit>
+
+RRIP::RRIP( discrete_t associativity , discrete_t nstes , Insertion insertion , bits_t rrpvBits ,
+            discrete_t throttle , discrete_t leaders , bits_t pselBits )
+    : SubstitutionPolitics( associativity ) , insertion( insertion ) ,
+      rrpvMax( ( uint8_t ) ( ( 1u << rrpvBits ) - 1 ) ) , throttle( throttle ) ,
+      dueling( nstes , insertion == Insertion::DYNAMIC ? leaders : 0 , pselBits ) {
+    rrpv = std::vector< uint8_t >( nstes * associativity , rrpvMax );
+}
+
+RRIP::~RRIP() {
+    rrpv.clear();
+}
+
+discrete_t RRIP::GetBlock( discrete_t index ) {
+    uint8_t *set = &rrpv[index * associativity];
+    uint8_t oldest = 0;
+    discrete_t victim = 0;
+    for ( discrete_t block = 0 ; block < associativity ; block++ ) {
+        if ( set[block] == rrpvMax ) {
+            return block;
+        }
+        if ( set[block] > oldest ) {
+            oldest = set[block];
+            victim = block;
+        }
+    }
+    // Aging every way until one reaches the distant value is the same as
+    // adding the gap to all of them in one pass.
+    uint8_t gap = ( uint8_t ) ( rrpvMax - oldest );
+    for ( discrete_t block = 0 ; block < associativity ; block++ ) {
+        set[block] = ( uint8_t ) ( set[block] + gap );
+    }
+    return victim;
+}
+
+discrete_t RRIP::GetBlockIn( discrete_t index , uint64_t ways ) {
+    uint8_t *set = &rrpv[index * associativity];
+    uint8_t oldest = 0;
+    discrete_t victim = ( discrete_t ) std::countr_zero( ways );
+    for ( discrete_t block = victim ; block < associativity ; block++ ) {
+        if ( !( ( ways >> block ) & 1 ) ) {
+            continue;
+        }
+        if ( set[block] == rrpvMax ) {
+            return block;
+        }
+        if ( set[block] > oldest ) {
+            oldest = set[block];
+            victim = block;
+        }
+    }
+    // Only the partition ages, the other ways are not candidates.
+    uint8_t gap = ( uint8_t ) ( rrpvMax - oldest );
+    for ( discrete_t block = 0 ; block < associativity ; block++ ) {
+        if ( ( ways >> block ) & 1 ) {
+            set[block] = ( uint8_t ) ( set[block] + gap );
+        }
+    }
+    return victim;
+}
+
+void RRIP::Refresh( discrete_t index , discrete_t block ) {
+    rrpv[index * associativity + block] = 0;
+}
+
+void RRIP::Insert( discrete_t index , discrete_t block ) {
+    bool bimodal = false;
+    switch ( insertion ) {
+    case Insertion::STATIC:
+        break;
+    case Insertion::BIMODAL:
+        bimodal = true;
+        break;
+    case Insertion::DYNAMIC:
+        dueling.Miss( index );
+        bimodal = dueling.UseB( index );
+        break;
+    }
+    uint8_t value = ( uint8_t ) ( rrpvMax - 1 );
+    if ( bimodal && Bimodal() ) {
+        value = rrpvMax;
+    }
+    rrpv[index * associativity + block] = value;
+}
+
+bool RRIP::Bimodal() {
+    // Distant insertion except once every `throttle` fills on average.
+    return throttle == 0 || gen() % throttle != 0;
+}
+
+void RRIP::Serialize( Archive &archive ) {
+    archive( rrpv )( dueling )( gen );
+}
@@ -0,0 +1,69 @@
+#include "Backend/SHiP.hpp"
+
+SHiP::SHiP( discrete_t associativity , discrete_t nstes , bits_t rrpvBits , bits_t regionShift ,
+            bits_t shctBits , bool bypass )
+    : RRIP( associativity , nstes , Insertion::STATIC , rrpvBits , 0 , 0 , 1 ) , nsets( nstes ) ,
+      regionShift( regionShift ) , bypass( bypass ) {
+    lines = std::vector< Line >( nstes * associativity );
+    // Start weakly alive so nothing is bypassed before it has been observed.
+    shct = std::vector< uint8_t >( ( size_t ) 1 << shctBits , 1 );
+}
+
+SHiP::~SHiP() {
+    lines.clear();
+    shct.clear();
+}
+
+void SHiP::Miss( discrete_t index , discrete_t tag ) {
+    discrete_t region = ( tag * nsets + index ) >> regionShift;
+    region *= 0x9E3779B97F4A7C15ull;
+    pending = ( uint16_t ) ( ( region >> 32 ) & ( shct.size() - 1 ) );
+}
+
+bool SHiP::Bypass( [[maybe_unused]] discrete_t index ) {
+    if ( !bypass || shct[pending] != 0 ) {
+        return false;
+    }
+    // Still insert one predicted dead block in 32, at distant RRPV, so the
+    // signature keeps training and can come back to life.
+    return ++deadMisses % 32 != 0;
+}
+
+void SHiP::Refresh( discrete_t index , discrete_t block ) {
+    RRIP::Refresh( index , block );
+    Line &line = lines[index * associativity + block];
+    if ( !line.reused ) {
+        line.reused = true;
+        if ( shct[line.signature] < COUNTER_MAX ) {
+            shct[line.signature]++;
+        }
+    }
+}
+
+void SHiP::Insert( discrete_t index , discrete_t block ) {
+    Line &line = lines[index * associativity + block];
+    if ( line.valid ) {
+        predictions++;
+        if ( line.dead != line.reused ) {
+            correct++;
+        }
+        if ( !line.reused && shct[line.signature] > 0 ) {
+            shct[line.signature]--;
+        }
+    }
+    line.signature = pending;
+    line.valid = true;
+    line.reused = false;
+    line.dead = shct[pending] == 0;
+    rrpv[index * associativity + block] = line.dead ? rrpvMax : ( uint8_t ) ( rrpvMax - 1 );
+}
+
+void SHiP::Report( CacheReport &report ) {
+    report.predictions = predictions;
+    report.correct_predictions = correct;
+}
+
+void SHiP::Serialize( Archive &archive ) {
+    RRIP::Serialize( archive );
+    archive( lines )( shct )( deadMisses )( pending )( predictions )( correct );
+}
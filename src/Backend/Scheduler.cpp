@@ -0,0 +1,53 @@
+#include "Backend/Scheduler.hpp"
+#include "Backend/Timing.hpp"
+
+#include <algorithm>
+
+Scheduler::Scheduler() {
+}
+
+Scheduler::~Scheduler() {
+    members.clear();
+}
+
+EventQueue &Scheduler::Events() {
+    return events;
+}
+
+void Scheduler::Join( Timing *timing ) {
+    members.push_back( timing );
+}
+
+void Scheduler::Drained() {
+    drained = true;
+}
+
+discrete_t Scheduler::Horizon( discrete_t arrival ) const {
+    discrete_t horizon = ~( discrete_t ) 0;
+    for ( const Timing *member : members ) {
+        horizon = std::min( horizon , member->Earliest( arrival ) );
+    }
+    return horizon;
+}
+
+void Scheduler::Advance( Timing *timing , discrete_t arrival ) {
+    discrete_t until = Horizon( arrival );
+    while ( events.RunNext( until ) ) {
+        if ( drained ) {
+            drained = false;
+            until = Horizon( arrival );
+        }
+    }
+    drained = false;
+    while ( timing->Backlog() > LOOKAHEAD && events.RunNext() ) {
+    }
+}
+
+void Scheduler::Finish() {
+    events.Run();
+    drained = false;
+}
+
+void Scheduler::Serialize( Archive &archive ) {
+    archive( events );
+}
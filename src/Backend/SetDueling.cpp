@@ -0,0 +1,67 @@
+#include "Backend/SetDueling.hpp"
+
+#include <iostream>
+
+SetDueling::SetDueling( discrete_t nsets , discrete_t leaders , bits_t pselBits ) {
+    roles = std::vector< Role >( nsets , Role::FOLLOWER );
+    pselMax = ( ( discrete_t ) 1 << pselBits ) - 1;
+    psel = pselMax / 2;
+    // One set cannot lead for both policies, PSEL would never be trained.
+    if ( leaders > 0 && nsets < 2 ) {
+        std::cout << "Set dueling (DRRIP, DIP) needs at least two sets\n\tHALTING PROGRAM\n";
+        exit(0);
+    }
+    if ( leaders > nsets / 2 ) {
+        leaders = nsets / 2;
+    }
+    if ( leaders == 0 ) {
+        return;
+    }
+    // Complement-select: constituency c leads A on its c-th set and B on its
+    // c-th set from the end, which spreads both groups over the whole index range.
+    discrete_t region = nsets / leaders;
+    for ( discrete_t c = 0 ; c < leaders ; c++ ) {
+        discrete_t offset = c % region;
+        roles[c * region + offset] = Role::LEADER_A;
+        if ( region - 1 - offset != offset ) {
+            roles[c * region + region - 1 - offset] = Role::LEADER_B;
+        }
+    }
+}
+
+SetDueling::~SetDueling() {
+    roles.clear();
+}
+
+void SetDueling::Miss( discrete_t index ) {
+    switch ( roles[index] ) {
+    case Role::LEADER_A:
+        if ( psel < pselMax ) {
+            psel++;
+        }
+        break;
+    case Role::LEADER_B:
+        if ( psel > 0 ) {
+            psel--;
+        }
+        break;
+    case Role::FOLLOWER:
+        break;
+    }
+}
+
+bool SetDueling::UseB( discrete_t index ) const {
+    switch ( roles[index] ) {
+    case Role::LEADER_A:
+        return false;
+    case Role::LEADER_B:
+        return true;
+    case Role::FOLLOWER:
+        break;
+    }
+    return psel > pselMax / 2;
+}
+
+void SetDueling::Serialize( Archive &archive ) {
+    archive( psel );
+}
@@ -0,0 +1,118 @@
+#include "Backend/SharingProfiler.hpp"
+
+#include <algorithm>
+#include <bit>
+
+SharingProfiler::SharingProfiler( bits_t offsetBits , discrete_t accessSize )
+    : offsetBits( offsetBits ) , granuleBits( ( bits_t ) ( offsetBits > 6 ? offsetBits - 6 : 0 ) ) ,
+      accessSize( accessSize == 0 ? 1 : accessSize ) {
+}
+
+SharingProfiler::~SharingProfiler() {
+    lines.clear();
+}
+
+// Bits of the granules an access of `accessSize` bytes at `addr` covers,
+// cut at the end of the block.
+uint64_t SharingProfiler::Bytes( addr_t addr ) const {
+    discrete_t offset = addr & ( ( ( discrete_t ) 1 << offsetBits ) - 1 );
+    discrete_t last = std::min( offset + accessSize , ( discrete_t ) 1 << offsetBits ) - 1;
+    discrete_t first = offset >> granuleBits;
+    discrete_t width = ( last >> granuleBits ) - first + 1;
+    uint64_t mask = width >= 64 ? ~( uint64_t ) 0 : ( ( uint64_t ) 1 << width ) - 1;
+    return mask << first;
+}
+
+void SharingProfiler::Invalidate( addr_t addr , discrete_t core ) {
+    Line &line = lines[( discrete_t ) addr >> offsetBits];
+    line.hotspot.invalidations++;
+    line.hotspot.cores |= ( uint64_t ) 1 << ( core & 63 );
+    for ( Copy &copy : line.copies ) {
+        if ( copy.core == core ) {
+            copy = Copy{ ( uint16_t ) core };
+            return;
+        }
+    }
+    line.copies.push_back( Copy{ ( uint16_t ) core } );
+}
+
+void SharingProfiler::Access( addr_t addr , discrete_t core , AccessType type , bool coherenceMiss ) {
+    auto it = lines.find( ( discrete_t ) addr >> offsetBits );
+    if ( it == lines.end() ) {
+        return;
+    }
+    Line &line = it->second;
+    uint64_t bytes = Bytes( addr );
+    if ( type == AccessType::WRITE ) {
+        line.hotspot.cores |= ( uint64_t ) 1 << ( core & 63 );
+    }
+    discrete_t dropped = line.copies.size();
+    for ( discrete_t at = 0 ; at < line.copies.size() ; at++ ) {
+        Copy &copy = line.copies[at];
+        if ( copy.core != core ) {
+            if ( type == AccessType::WRITE && !copy.live ) {
+                copy.written |= bytes;
+            }
+            continue;
+        }
+        if ( coherenceMiss ) {
+            copy.live = true;
+            copy.trueSharing = false;
+            line.hotspot.falseSharing++;
+            falseSharing++;
+        } else if ( !copy.live ) {
+            // The block came back through an ordinary miss, nothing to classify.
+            dropped = at;
+            continue;
+        }
+        if ( !copy.trueSharing && ( copy.written & bytes ) != 0 ) {
+            copy.trueSharing = true;
+            line.hotspot.falseSharing--;
+            line.hotspot.trueSharing++;
+            falseSharing--;
+            trueSharing++;
+        }
+    }
+    if ( dropped < line.copies.size() ) {
+        line.copies[dropped] = line.copies.back();
+        line.copies.pop_back();
+    }
+}
+
+discrete_t SharingProfiler::TrueSharing() const {
+    return trueSharing;
+}
+
+discrete_t SharingProfiler::FalseSharing() const {
+    return falseSharing;
+}
+
+std::vector< SharingProfiler::Hotspot > SharingProfiler::Ranked( discrete_t top , bits_t regionBits ) const {
+    bits_t shift = regionBits > offsetBits ? regionBits : offsetBits;
+    std::unordered_map< discrete_t , Hotspot > regions;
+    for ( const auto &[block , line] : lines ) {
+        discrete_t key = ( block << offsetBits ) >> shift;
+        Hotspot &region = regions[key];
+        region.addr = key << shift;
+        region.invalidations += line.hotspot.invalidations;
+        region.trueSharing += line.hotspot.trueSharing;
+        region.falseSharing += line.hotspot.falseSharing;
+        region.cores |= line.hotspot.cores;
+    }
+    std::vector< Hotspot > ranked;
+    ranked.reserve( regions.size() );
+    for ( const auto &[key , region] : regions ) {
+        ranked.push_back( region );
+    }
+    discrete_t count = std::min< discrete_t >( top , ranked.size() );
+    std::partial_sort( ranked.begin() , ranked.begin() + ( std::ptrdiff_t ) count , ranked.end() ,
+                       []( const Hotspot &a , const Hotspot &b ) {
+                           return a.invalidations != b.invalidations ? a.invalidations > b.invalidations : a.addr < b.addr;
+                       } );
+    ranked.resize( count );
+    return ranked;
+}
+
+void SharingProfiler::Serialize( Archive &archive ) {
+    archive( lines )( trueSharing )( falseSharing );
+}
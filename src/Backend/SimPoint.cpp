@@ -0,0 +1,143 @@
+#include "Backend/SimPoint.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+SimPoint::SimPoint( discrete_t length , bits_t region , discrete_t dims ) :
+    length( length < 1 ? 1 : length ) , region( region ) , dims( dims < 1 ? 1 : dims ) {
+}
+
+SimPoint::~SimPoint() {
+    features.clear();
+}
+
+// A fixed pseudo-random weight in [-1, 1) per region and dimension, hashed
+// rather than stored.
+double SimPoint::Projection( discrete_t region , discrete_t dim ) const {
+    discrete_t h = region * dims + dim + 0x9E3779B97F4A7C15ull;
+    h = ( h ^ ( h >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    h = ( h ^ ( h >> 27 ) ) * 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return ( double ) ( h >> 11 ) * 0x1.0p-52 - 1.0;
+}
+
+double SimPoint::Distance( const std::vector< double > &a , const std::vector< double > &b ) {
+    double distance = 0.0;
+    for ( size_t dim = 0 ; dim < a.size() ; dim++ ) {
+        distance += ( a[dim] - b[dim] ) * ( a[dim] - b[dim] );
+    }
+    return distance;
+}
+
+void SimPoint::Access( addr_t addr ) {
+    regions[( discrete_t ) addr >> region]++;
+    if ( ++current == length ) {
+        Finish();
+    }
+}
+
+void SimPoint::Finish() {
+    if ( current == 0 ) {
+        return;
+    }
+    std::vector< double > feature( dims , 0.0 );
+    for ( auto [key , count] : regions ) {
+        double share = ( double ) count / ( double ) current;
+        for ( discrete_t dim = 0 ; dim < dims ; dim++ ) {
+            feature[dim] += share * Projection( key , dim );
+        }
+    }
+    features.push_back( std::move( feature ) );
+    sizes.push_back( current );
+    regions.clear();
+    current = 0;
+}
+
+discrete_t SimPoint::Intervals() const {
+    return features.size();
+}
+
+discrete_t SimPoint::Length() const {
+    return length;
+}
+
+discrete_t SimPoint::Size( discrete_t interval ) const {
+    return sizes[interval];
+}
+
+std::vector< SimPoint::Phase > SimPoint::Cluster( discrete_t k , discrete_t seed ) const {
+    discrete_t n = features.size();
+    k = std::min( std::max< discrete_t >( k , 1 ) , n );
+    std::vector< Phase > phases;
+    if ( n == 0 ) {
+        return phases;
+    }
+    // k-means++: each next centroid drawn in proportion to the squared
+    // distance to the closest one so far.
+    std::mt19937_64 random( seed );
+    std::vector< std::vector< double > > centroids;
+    centroids.push_back( features[std::uniform_int_distribution< discrete_t >( 0 , n - 1 )( random )] );
+    std::vector< double > closest( n , std::numeric_limits< double >::max() );
+    while ( centroids.size() < k ) {
+        double total = 0.0;
+        for ( discrete_t i = 0 ; i < n ; i++ ) {
+            closest[i] = std::min( closest[i] , Distance( features[i] , centroids.back() ) );
+            total += closest[i];
+        }
+        if ( total == 0.0 ) {
+            break;
+        }
+        double pick = std::uniform_real_distribution< double >( 0.0 , total )( random );
+        discrete_t next = 0;
+        while ( next + 1 < n && ( pick -= closest[next] ) > 0.0 ) {
+            next++;
+        }
+        centroids.push_back( features[next] );
+    }
+
+    // Lloyd's iterations until no interval changes cluster.
+    std::vector< discrete_t > assignment( n , centroids.size() );
+    for ( discrete_t round = 0 ; round < 100 ; round++ ) {
+        bool changed = false;
+        for ( discrete_t i = 0 ; i < n ; i++ ) {
+            discrete_t best = 0;
+            for ( discrete_t c = 1 ; c < centroids.size() ; c++ ) {
+                if ( Distance( features[i] , centroids[c] ) < Distance( features[i] , centroids[best] ) ) {
+                    best = c;
+                }
+            }
+            changed |= assignment[i] != best;
+            assignment[i] = best;
+        }
+        if ( !changed ) {
+            break;
+        }
+        std::vector< discrete_t > counts( centroids.size() , 0 );
+        std::vector< std::vector< double > > sums( centroids.size() , std::vector< double >( dims , 0.0 ) );
+        for ( discrete_t i = 0 ; i < n ; i++ ) {
+            counts[assignment[i]]++;
+            for ( discrete_t dim = 0 ; dim < dims ; dim++ ) {
+                sums[assignment[i]][dim] += features[i][dim];
+            }
+        }
+        for ( discrete_t c = 0 ; c < centroids.size() ; c++ ) {
+            for ( discrete_t dim = 0 ; counts[c] > 0 && dim < dims ; dim++ ) {
+                centroids[c][dim] = sums[c][dim] / ( double ) counts[c];
+            }
+        }
+    }
+
+    phases = std::vector< Phase >( centroids.size() );
+    for ( discrete_t i = 0 ; i < n ; i++ ) {
+        Phase &phase = phases[assignment[i]];
+        if ( phase.members.empty() ||
+             Distance( features[i] , centroids[assignment[i]] ) < Distance( features[phase.representative] , centroids[assignment[i]] ) ) {
+            phase.representative = i;
+        }
+        phase.members.push_back( i );
+        phase.accesses += sizes[i];
+    }
+    std::erase_if( phases , []( const Phase &phase ) { return phase.members.empty(); } );
+    return phases;
+}
@@ -0,0 +1,34 @@
+#include "Backend/SkewedIndexing.hpp"
+
+SkewedIndexing::SkewedIndexing( discrete_t nsets , discrete_t assoc ) : Indexing( nsets ) {
+    seeds = std::vector< uint64_t >( assoc );
+    // Odd multipliers drawn from splitmix64 so every way gets a different hash.
+    uint64_t state = 0;
+    for ( uint64_t &seed : seeds ) {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t z = state;
+        z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+        z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+        seed = ( z ^ ( z >> 31 ) ) | 1;
+    }
+}
+
+SkewedIndexing::~SkewedIndexing() {
+    seeds.clear();
+}
+
+discrete_t SkewedIndexing::Index( discrete_t block , discrete_t way ) const {
+    uint64_t h = ( block + 1 ) * seeds[way];
+    h ^= h >> 29;
+    // Lemire's range reduction maps the top 32 bits onto [0, nsets) with a
+    // multiplication, which also works for non power-of-two set counts.
+    return ( ( h >> 32 ) * nsets ) >> 32;
+}
+
+discrete_t SkewedIndexing::Tag( discrete_t block ) const {
+    return block;
+}
+
+discrete_t SkewedIndexing::Block( [[maybe_unused]] discrete_t index , discrete_t tag ) const {
+    return tag;
+}
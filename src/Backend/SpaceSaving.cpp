@@ -0,0 +1,57 @@
+#include "Backend/SpaceSaving.hpp"
+
+#include <algorithm>
+
+SpaceSaving::SpaceSaving( discrete_t capacity ) : slots( std::max< discrete_t >( capacity , 1 ) ) ,
+                                                  last( std::max< discrete_t >( capacity , 1 ) ) {
+    counters = std::vector< Counter >( std::max< discrete_t >( capacity , 1 ) , { 0 , 0 , 0 } );
+    last.Insert( 0 , ( uint32_t ) ( counters.size() - 1 ) );
+}
+
+SpaceSaving::~SpaceSaving() {
+    counters.clear();
+}
+
+// Moves the counter to the end of its run of equal counts and bumps it, which
+// makes it the first of the next run.
+void SpaceSaving::Increment( uint32_t slot ) {
+    discrete_t count = counters[slot].count;
+    uint32_t end = last.Find( count );
+    std::swap( counters[slot] , counters[end] );
+    if ( counters[slot].count > 0 ) {
+        slots.Insert( counters[slot].key , slot );
+    }
+    slots.Insert( counters[end].key , end );
+    counters[end].count++;
+    if ( end == 0 || counters[end - 1].count != count ) {
+        last.Erase( count );
+    } else {
+        last.Insert( count , end - 1 );
+    }
+    if ( end + 1 == counters.size() || counters[end + 1].count != count + 1 ) {
+        last.Insert( count + 1 , end );
+    }
+}
+
+void SpaceSaving::Add( discrete_t key ) {
+    uint32_t slot = slots.Find( key );
+    if ( slot == FlatMap::NONE ) {
+        // The smallest counter changes hands.
+        Counter &smallest = counters[0];
+        if ( smallest.count > 0 ) {
+            slots.Erase( smallest.key );
+        }
+        smallest.key = key;
+        smallest.error = smallest.count;
+        slot = 0;
+    }
+    Increment( slot );
+}
+
+std::vector< SpaceSaving::Counter > SpaceSaving::Top( discrete_t count ) const {
+    std::vector< Counter > top;
+    for ( size_t slot = counters.size() ; slot-- > 0 && top.size() < count && counters[slot].count > 0 ; ) {
+        top.push_back( counters[slot] );
+    }
+    return top;
+}
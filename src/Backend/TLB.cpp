@@ -0,0 +1,63 @@
+#include "Backend/TLB.hpp"
+
+#include <bit>
+#include <string>
+#include <vector>
+
+TLB::TLB( const Options &options ) {
+    discrete_t pageSize = PageSize( options );
+    std::string repl = options.get( "tlb-repl" , "L" );
+    // Levels only inherit the seeding, every other option is about the data cache.
+    std::vector< std::string > seeding;
+    if ( options.has( "deterministic" ) ) {
+        seeding = { "--deterministic" , "--seed=" + options.get( "seed" , "1" ) };
+    }
+    Options levels( seeding );
+    l1 = MakeLevel( options.get( "tlb-l1-sets" , 16 ) , pageSize , options.get( "tlb-l1-assoc" , 4 ) , repl , levels );
+    l2 = MakeLevel( options.get( "tlb-l2-sets" , 128 ) , pageSize , options.get( "tlb-l2-assoc" , 8 ) , repl , levels );
+    l2Latency = options.get( "tlb-l2-latency" , 7 );
+    walkLatency = options.get( "walk-latency" , 30 );
+    discrete_t vpnBits = 32 - ( discrete_t ) std::countr_zero( pageSize );
+    walkLevels = ( vpnBits + 8 ) / 9;
+}
+
+TLB::~TLB() {
+}
+
+discrete_t TLB::PageSize( const Options &options ) {
+    discrete_t pageSize = options.get( "page-size" , 4096 );
+    // Smaller pages would give the page mapper millions of frames to track.
+    if ( !std::has_single_bit( pageSize ) || pageSize < 1024 ) {
+        std::cout << "The page size must be a power of two of at least 1024\n\tHALTING PROGRAM\n";
+        exit(0);
+    }
+    return pageSize;
+}
+
+std::unique_ptr< Cache > TLB::MakeLevel( discrete_t nsets , discrete_t pageSize , discrete_t assoc , const std::string &repl ,
+                                        const Options &options ) {
+    std::vector< std::string > command = { std::to_string( nsets ) , std::to_string( pageSize ) , std::to_string( assoc ) , repl };
+    return std::make_unique< Cache >( std::span( command ) , options );
+}
+
+discrete_t TLB::Translate( addr_t addr ) {
+    if ( l1.get()->process( addr ).res == AccessResult::HIT ) {
+        return 0;
+    }
+    if ( l2.get()->process( addr ).res != AccessResult::HIT ) {
+        walks++;
+        return l2Latency + walkLevels * walkLatency;
+    }
+    return l2Latency;
+}
+
+void TLB::Report( CacheReport &report ) {
+    report.tlb_l1_hits = l1.get()->report().hits;
+    report.tlb_l2_hits = l2.get()->report().hits;
+    report.page_walks = walks;
+    report.walk_cycles = walks * walkLevels * walkLatency;
+}
+
+void TLB::Serialize( Archive &archive ) {
+    archive( l1 )( l2 )( walks );
+}
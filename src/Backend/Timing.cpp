@@ -0,0 +1,222 @@
+#include "Backend/Timing.hpp"
+
+#include <algorithm>
+#include <bit>
+
+Timing::Timing( const Options &options )
+    : hitLatency( options.get( "hit-latency" , 4 ) ) , memoryLatency( options.get( "memory-latency" , 200 ) ) ,
+      writebackLatency( options.get( "writeback-latency" , 0 ) ) , issueInterval( options.get( "issue-interval" , 1 ) ) ,
+      bankCycles( options.get( "bank-cycles" , 1 ) ) {
+    mshrs = std::vector< Mshr >( options.get( "mshrs" , 0 ) );
+    bankFree = std::vector< discrete_t >( std::max< discrete_t >( options.get( "banks" , 1 ) , 1 ) , 0 );
+    Attach( std::make_shared<Scheduler>() );
+}
+
+Timing::~Timing() {
+    mshrs.clear();
+    bankFree.clear();
+}
+
+void Timing::Attach( std::shared_ptr< Scheduler > shared ) {
+    scheduler = std::move( shared );
+    scheduler.get()->Join( this );
+    stepHandler = scheduler.get()->Events().Register( &Timing::Stepped , this );
+    fillHandler = scheduler.get()->Events().Register( &Timing::Filled , this );
+}
+
+void Timing::SetMemory( std::shared_ptr< DRAM > shared , std::shared_ptr< Scheduler > clock ) {
+    dram = std::move( shared );
+    if ( clock ) {
+        Attach( std::move( clock ) );
+    }
+}
+
+discrete_t Timing::Latency( bool hit , bool wroteBack , discrete_t translation , discrete_t memory ) const {
+    discrete_t latency = translation + hitLatency;
+    if ( !hit ) {
+        latency += memory;
+    }
+    if ( wroteBack ) {
+        latency += writebackLatency;
+    }
+    return latency;
+}
+
+// Sends the requests of an access that leaves the cache at `time` and returns
+// how long its fetch takes.
+discrete_t Timing::Memory( discrete_t time , std::span< const MemoryRequest > requests ) {
+    if ( !dram ) {
+        return memoryLatency;
+    }
+    discrete_t latency = 0;
+    for ( const MemoryRequest &request : requests ) {
+        discrete_t cycles = dram.get()->Access( request , time );
+        if ( !request.write ) {
+            latency = std::max( latency , cycles );
+        }
+    }
+    return latency;
+}
+
+void Timing::Access( AccessType type , discrete_t block , bool hit , bool wroteBack , discrete_t translation , discrete_t arrival ,
+                     const std::vector< MemoryRequest > &requests ) {
+    inbox.push_back( { type , block , hit , wroteBack , translation , arrival , requests.size() } );
+    outgoing.insert( outgoing.end() , requests.begin() , requests.end() );
+    if ( inbox.size() == 1 ) {
+        Begin();
+    }
+    scheduler.get()->Advance( this , arrival );
+}
+
+discrete_t Timing::Earliest( discrete_t arrival ) const {
+    if ( !inbox.empty() ) {
+        return ~( discrete_t ) 0;
+    }
+    return mshrs.empty() ? end : std::max( arrival , clock );
+}
+
+size_t Timing::Backlog() const {
+    return inbox.size();
+}
+
+void Timing::Finish() {
+    scheduler.get()->Finish();
+}
+
+// Issues the oldest pending access and wakes it up once its bank is free. A
+// blocking cache starts it when the previous access is done.
+void Timing::Begin() {
+    const Pending &access = inbox.front();
+    if ( mshrs.empty() ) {
+        issue = end;
+        start = end;
+    } else {
+        issue = std::max( access.arrival , clock );
+        start = issue;
+        discrete_t &bank = bankFree[access.block % bankFree.size()];
+        if ( bank > start ) {
+            bankStalls += bank - start;
+            start = bank;
+        }
+        bank = start + bankCycles;
+    }
+    scheduler.get()->Events().Schedule( start , stepHandler );
+}
+
+void Timing::Step() {
+    const Pending &access = inbox.front();
+    std::span< const MemoryRequest > requests( outgoing.data() + sent , access.requests );
+    discrete_t latency;
+    if ( mshrs.empty() ) {
+        latency = Latency( access.hit , access.wroteBack , access.translation ,
+                           Memory( end + access.translation + hitLatency , requests ) );
+        end += latency;
+    } else if ( !NonBlocking( access , requests , latency ) ) {
+        return;
+    }
+    latencies += latency;
+    discrete_t bucket = latency == 0 ? 0 : ( discrete_t ) std::bit_width( latency ) - 1;
+    histograms[( size_t ) access.type][std::min( bucket , BUCKETS - 1 )]++;
+    sent += access.requests;
+    inbox.pop_front();
+    if ( inbox.empty() ) {
+        outgoing.clear();
+        sent = 0;
+        scheduler.get()->Drained();
+        return;
+    }
+    if ( sent > outgoing.size() / 2 ) {
+        outgoing.erase( outgoing.begin() , outgoing.begin() + ( std::ptrdiff_t ) sent );
+        sent = 0;
+    }
+    Begin();
+}
+
+// Times the oldest pending access, which has started. Returns false when it
+// has to wait for an MSHR; the next fill wakes it up.
+bool Timing::NonBlocking( const Pending &access , std::span< const MemoryRequest > requests , discrete_t &latency ) {
+    // A block still being fetched is a secondary miss even if the functional
+    // cache already holds it.
+    discrete_t done = start + access.translation + hitLatency;
+    Mshr *pending = nullptr;
+    for ( Mshr &mshr : mshrs ) {
+        if ( mshr.done > start && mshr.block == access.block ) {
+            pending = &mshr;
+            break;
+        }
+    }
+    if ( pending ) {
+        merged++;
+        done = std::max( done , pending->done );
+        Memory( start + access.translation + hitLatency , requests );
+    } else if ( !access.hit ) {
+        Mshr *free = &mshrs[0];
+        for ( Mshr &mshr : mshrs ) {
+            if ( mshr.done < free->done ) {
+                free = &mshr;
+            }
+        }
+        if ( free->done > start ) {
+            if ( free->done > scheduler.get()->Events().Now() ) {
+                waiting = true;
+                return false;
+            }
+            mshrStalls += free->done - start;
+            start = free->done;
+        }
+        free->block = access.block;
+        free->done = start + Latency( false , access.wroteBack , access.translation ,
+                                      Memory( start + access.translation + hitLatency , requests ) );
+        mshrBusy += free->done - start;
+        done = free->done;
+        scheduler.get()->Events().Schedule( free->done , fillHandler );
+    } else if ( dram ) {
+        Memory( start + access.translation + hitLatency , requests );
+    }
+    // Issue is in order, so whatever held this access back holds the next.
+    clock = start + issueInterval;
+    end = std::max( end , done );
+    latency = done - issue;
+    return true;
+}
+
+void Timing::Stepped( void *timing ) {
+    static_cast< Timing * >( timing )->Step();
+}
+
+void Timing::Filled( void *timing ) {
+    Timing *self = static_cast< Timing * >( timing );
+    if ( self->waiting ) {
+        self->waiting = false;
+        self->Step();
+    }
+}
+
+void Timing::Merge( const Timing &other ) {
+    for ( size_t type = 0 ; type < histograms.size() ; type++ ) {
+        for ( discrete_t bucket = 0 ; bucket < BUCKETS ; bucket++ ) {
+            histograms[type][bucket] += other.histograms[type][bucket];
+        }
+    }
+}
+
+void Timing::Report( CacheReport &report ) const {
+    report.total_cycles = end;
+    report.latency_cycles = latencies;
+    report.merged_misses = merged;
+    report.mshr_stall_cycles = mshrStalls;
+    report.bank_stall_cycles = bankStalls;
+    report.mshr_busy_cycles = mshrBusy;
+    if ( dram ) {
+        dram.get()->Report( report );
+    }
+}
+
+const Timing::Histogram &Timing::Latencies( AccessType type ) const {
+    return histograms[( size_t ) type];
+}
+
+void Timing::Serialize( Archive &archive ) {
+    archive( mshrs )( bankFree )( clock )( end )( latencies )( merged )( mshrStalls )( bankStalls )( mshrBusy )( histograms );
+    archive( inbox )( outgoing )( sent )( issue )( start )( waiting )( dram )( scheduler );
+}
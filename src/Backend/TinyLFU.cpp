@@ -0,0 +1,89 @@
+#include "Backend/TinyLFU.hpp"
+
+#include <algorithm>
+
+TinyLFU::TinyLFU( discrete_t associativity , discrete_t nstes , discrete_t windowPercent , discrete_t protectedPercent )
+    : DirectoryPolitics( associativity , nstes , associativity ) ,
+      // One counter per block in each row is 2 bytes of sketch per block.
+      sketch( associativity * nstes , 10 * associativity * nstes ) ,
+      windowSize( std::clamp< discrete_t >( associativity * windowPercent / 100 , 1 , associativity ) ) {
+    protectedSize = ( associativity - windowSize ) * protectedPercent / 100;
+    sets = std::vector< Set >( nstes );
+}
+
+TinyLFU::~TinyLFU() {
+    sets.clear();
+}
+
+void TinyLFU::Move( Set &set , uint32_t node , List to ) {
+    set.lists[nodes[node].list].Remove( nodes , node );
+    set.lists[to].PushFront( nodes , node );
+    nodes[node].list = to;
+}
+
+void TinyLFU::Miss( discrete_t index , discrete_t tag ) {
+    DirectoryPolitics::Miss( index , tag );
+    sketch.Increment( pendingKey );
+}
+
+discrete_t TinyLFU::GetBlock( discrete_t index ) {
+    Set &set = sets[index];
+    TinyLFUList &window = set.lists[WINDOW];
+    TinyLFUList &probation = set.lists[PROBATION];
+    TinyLFUList &protect = set.lists[PROTECTED];
+    if ( window.size + probation.size + protect.size < associativity ) {
+        return 0; // The set still has invalid ways, the cache fills one of those.
+    }
+    uint32_t victim = !probation.Empty() ? probation.Back() : protect.Back();
+    if ( window.Empty() ) {
+        set.lists[nodes[victim].list].Remove( nodes , victim );
+        Release( victim );
+        return nodes[victim].way; // Released nodes keep their contents until reused.
+    }
+    uint32_t candidate = window.Back();
+    if ( victim != Link::NIL && sketch.Estimate( nodes[candidate].key ) > sketch.Estimate( nodes[victim].key ) ) {
+        Move( set , candidate , PROBATION );
+        set.lists[nodes[victim].list].Remove( nodes , victim );
+    } else {
+        window.Remove( nodes , candidate );
+        victim = candidate;
+    }
+    Release( victim );
+    return nodes[victim].way;
+}
+
+void TinyLFU::Refresh( discrete_t index , discrete_t block ) {
+    Set &set = sets[index];
+    uint32_t node = NodeAt( index , block );
+    sketch.Increment( nodes[node].key );
+    switch ( nodes[node].list ) {
+    case WINDOW:
+    case PROTECTED:
+        set.lists[nodes[node].list].MoveToFront( nodes , node );
+        break;
+    case PROBATION:
+        Move( set , node , PROTECTED );
+        if ( set.lists[PROTECTED].size > protectedSize ) {
+            Move( set , set.lists[PROTECTED].Back() , PROBATION );
+        }
+        break;
+    }
+}
+
+void TinyLFU::Insert( discrete_t index , discrete_t block ) {
+    Set &set = sets[index];
+    uint32_t node = Allocate( pendingKey );
+    nodes[node].list = WINDOW;
+    set.lists[WINDOW].PushFront( nodes , node );
+    // While the set fills up, window overflow goes to probation unopposed.
+    if ( set.lists[WINDOW].size > windowSize ) {
+        Move( set , set.lists[WINDOW].Back() , PROBATION );
+    }
+    Place( index , block , node );
+    pendingNode = NONE;
+}
+
+void TinyLFU::Serialize( Archive &archive ) {
+    DirectoryPolitics::Serialize( archive );
+    archive( sets )( sketch );
+}
@@ -0,0 +1,55 @@
+#include "Backend/TraceProfile.hpp"
+
+#include <algorithm>
+#include <bit>
+
+TraceProfile::TraceProfile( bits_t offset , bits_t precision , discrete_t counters ) :
+    offset( offset ) , window( precision ) , footprint( precision ) , hot( counters ) {
+}
+
+TraceProfile::~TraceProfile() {
+}
+
+discrete_t TraceProfile::From( discrete_t bucket ) {
+    return bucket == 0 ? 0 : ( discrete_t ) 1 << ( bucket - 1 );
+}
+
+void TraceProfile::Access( addr_t addr ) {
+    discrete_t block = ( discrete_t ) addr >> offset;
+    window.Add( block );
+    footprint.Add( block );
+    hot.Add( block );
+    if ( accesses > 0 ) {
+        Histogram &side = block >= last ? forward : backward;
+        discrete_t stride = block >= last ? block - last : last - block;
+        side[std::min< discrete_t >( ( discrete_t ) std::bit_width( stride ) , BUCKETS - 1 )]++;
+    }
+    last = block;
+    accesses++;
+}
+
+discrete_t TraceProfile::EndWindow() {
+    discrete_t distinct = window.Estimate();
+    window.Clear();
+    return distinct;
+}
+
+discrete_t TraceProfile::Footprint() const {
+    return footprint.Estimate();
+}
+
+discrete_t TraceProfile::Accesses() const {
+    return accesses;
+}
+
+const TraceProfile::Histogram &TraceProfile::Forward() const {
+    return forward;
+}
+
+const TraceProfile::Histogram &TraceProfile::Backward() const {
+    return backward;
+}
+
+std::vector< SpaceSaving::Counter > TraceProfile::Hottest( discrete_t count ) const {
+    return hot.Top( count );
+}
@@ -0,0 +1,71 @@
+#include "Backend/TwoQ.hpp"
+
+#include <algorithm>
+
+TwoQ::TwoQ( discrete_t associativity , discrete_t nstes , discrete_t inPercent , discrete_t outPercent )
+    : DirectoryPolitics( associativity , nstes , associativity + std::max< discrete_t >( 1 , associativity * outPercent / 100 ) + 1 ) ,
+      kin( std::max< discrete_t >( 1 , associativity * inPercent / 100 ) ) ,
+      kout( std::max< discrete_t >( 1 , associativity * outPercent / 100 ) ) {
+    sets = std::vector< Set >( nstes );
+}
+
+TwoQ::~TwoQ() {
+    sets.clear();
+}
+
+void TwoQ::Move( Set &set , uint32_t node , List to ) {
+    set.lists[nodes[node].list].Remove( nodes , node );
+    set.lists[to].PushFront( nodes , node );
+    nodes[node].list = to;
+}
+
+discrete_t TwoQ::GetBlock( discrete_t index ) {
+    Set &set = sets[index];
+    if ( set.lists[A1IN].size + set.lists[AM].size < associativity ) {
+        return 0; // The set still has invalid ways, the cache fills one of those.
+    }
+    if ( set.lists[A1IN].size > kin || set.lists[AM].Empty() ) {
+        uint32_t victim = set.lists[A1IN].Back();
+        Move( set , victim , A1OUT );
+        if ( set.lists[A1OUT].size > kout ) {
+            uint32_t ghost = set.lists[A1OUT].Back();
+            set.lists[A1OUT].Remove( nodes , ghost );
+            Release( ghost );
+            if ( ghost == pendingNode ) {
+                pendingNode = NONE;
+            }
+        }
+        return nodes[victim].way;
+    }
+    uint32_t victim = set.lists[AM].Back();
+    set.lists[AM].Remove( nodes , victim );
+    Release( victim );
+    return nodes[victim].way; // Released nodes keep their contents until reused.
+}
+
+void TwoQ::Refresh( discrete_t index , discrete_t block ) {
+    uint32_t node = NodeAt( index , block );
+    // Hits in A1in are correlated references and do not count.
+    if ( nodes[node].list == AM ) {
+        sets[index].lists[AM].MoveToFront( nodes , node );
+    }
+}
+
+void TwoQ::Insert( discrete_t index , discrete_t block ) {
+    Set &set = sets[index];
+    uint32_t node = pendingNode;
+    if ( node != NONE ) {
+        Move( set , node , AM );
+    } else {
+        node = Allocate( pendingKey );
+        nodes[node].list = A1IN;
+        set.lists[A1IN].PushFront( nodes , node );
+    }
+    Place( index , block , node );
+    pendingNode = NONE;
+}
+
+void TwoQ::Serialize( Archive &archive ) {
+    DirectoryPolitics::Serialize( archive );
+    archive( sets );
+}
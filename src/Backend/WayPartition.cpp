@@ -0,0 +1,153 @@
+#include "Backend/WayPartition.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+WayPartition::WayPartition( const Options &options , discrete_t nsets , discrete_t associativity , discrete_t programs )
+    : associativity( associativity ) , programs( programs ) , utility( options.has( "ucp" ) ) ,
+      length( std::max< discrete_t >( options.get( "partition-interval" , 100000 ) , 1 ) ) {
+    uint64_t all = associativity >= 64 ? ~( uint64_t ) 0 : ( ( uint64_t ) 1 << associativity ) - 1;
+    masks = std::vector< uint64_t >( programs , all );
+    if ( utility ) {
+        if ( programs > associativity ) {
+            std::cout << "UCP needs at least one way per program\n\tHALTING PROGRAM\n";
+            exit(0);
+        }
+        samples = std::clamp< discrete_t >( options.get( "ucp-sets" , 32 ) , 1 , nsets );
+        stride = nsets / samples;
+        stacks = std::vector< std::vector< discrete_t > >( programs * samples );
+        positionHits = std::vector< discrete_t >( programs * associativity , 0 );
+        // Nothing is known yet, so the ways start evenly split.
+        std::vector< discrete_t > ways( programs , associativity / programs );
+        for ( discrete_t program = 0 ; program < associativity % programs ; program++ ) {
+            ways[program]++;
+        }
+        Assign( ways );
+    } else {
+        std::istringstream list{ options.get( "cat" , "" ) };
+        std::string mask;
+        for ( discrete_t program = 0 ; program < programs && std::getline( list , mask , ',' ) ; program++ ) {
+            masks[program] = std::stoull( mask , nullptr , 0 ) & all;
+            if ( masks[program] == 0 ) {
+                std::cout << "CAT masks need at least one of the cache's ways\n\tHALTING PROGRAM\n";
+                exit(0);
+            }
+        }
+    }
+    current.ways = std::vector< discrete_t >( programs );
+    current.accesses = std::vector< discrete_t >( programs , 0 );
+    current.hits = std::vector< discrete_t >( programs , 0 );
+    for ( discrete_t program = 0 ; program < programs ; program++ ) {
+        current.ways[program] = ( discrete_t ) std::popcount( masks[program] );
+    }
+}
+
+WayPartition::~WayPartition() {
+    stacks.clear();
+    history.clear();
+}
+
+uint64_t WayPartition::Ways( uint16_t program ) const {
+    return masks[program % programs];
+}
+
+void WayPartition::Access( discrete_t index , discrete_t tag , uint16_t program , bool hit ) {
+    discrete_t owner = program % programs;
+    current.accesses[owner]++;
+    if ( hit ) {
+        current.hits[owner]++;
+    }
+    if ( utility && index % stride == 0 && index / stride < samples ) {
+        Monitor( index / stride , tag , owner );
+    }
+    if ( ++accesses % length == 0 ) {
+        Close();
+    }
+}
+
+// Hits at stack position p are hits the program would get with p + 1 ways.
+void WayPartition::Monitor( discrete_t sample , discrete_t tag , discrete_t program ) {
+    std::vector< discrete_t > &stack = stacks[program * samples + sample];
+    auto found = std::find( stack.begin() , stack.end() , tag );
+    if ( found != stack.end() ) {
+        positionHits[program * associativity + ( discrete_t ) ( found - stack.begin() )]++;
+        std::rotate( stack.begin() , found , found + 1 );
+        return;
+    }
+    if ( stack.size() < associativity ) {
+        stack.push_back( tag );
+    } else {
+        stack.back() = tag;
+    }
+    std::rotate( stack.begin() , stack.end() - 1 , stack.end() );
+}
+
+void WayPartition::Close() {
+    current.end = accesses;
+    history.push_back( current );
+    if ( utility ) {
+        Repartition();
+    }
+    for ( discrete_t program = 0 ; program < programs ; program++ ) {
+        current.ways[program] = ( discrete_t ) std::popcount( masks[program] );
+        current.accesses[program] = 0;
+        current.hits[program] = 0;
+    }
+}
+
+// Lookahead allocation: every program starts with one way, then the program
+// and way count with the highest hits per extra way win until none are left.
+// Partitions are handed out as contiguous masks and the monitors are halved
+// so older behaviour fades.
+void WayPartition::Repartition() {
+    std::vector< discrete_t > ways( programs , 1 );
+    discrete_t left = associativity - programs;
+    while ( left > 0 ) {
+        discrete_t best = 0 , bestWays = 1;
+        double bestUtility = -1.0;
+        for ( discrete_t program = 0 ; program < programs ; program++ ) {
+            discrete_t gained = 0;
+            const discrete_t *hits = &positionHits[program * associativity];
+            for ( discrete_t extra = 1 ; extra <= left ; extra++ ) {
+                gained += hits[ways[program] + extra - 1];
+                double utility = ( double ) gained / ( double ) extra;
+                if ( utility > bestUtility ) {
+                    bestUtility = utility;
+                    best = program;
+                    bestWays = extra;
+                }
+            }
+        }
+        ways[best] += bestWays;
+        left -= bestWays;
+    }
+    Assign( ways );
+    for ( discrete_t &hits : positionHits ) {
+        hits /= 2;
+    }
+}
+
+void WayPartition::Assign( const std::vector< discrete_t > &ways ) {
+    discrete_t first = 0;
+    for ( discrete_t program = 0 ; program < programs ; program++ ) {
+        uint64_t mask = ways[program] >= 64 ? ~( uint64_t ) 0 : ( ( uint64_t ) 1 << ways[program] ) - 1;
+        masks[program] = mask << first;
+        first += ways[program];
+    }
+}
+
+std::vector< WayPartition::Interval > WayPartition::History() const {
+    std::vector< Interval > intervals = history;
+    if ( accesses % length != 0 ) {
+        intervals.push_back( current );
+        intervals.back().end = accesses;
+    }
+    return intervals;
+}
+
+void WayPartition::Serialize( Archive &archive ) {
+    archive( masks )( stacks )( positionHits )( accesses )( current )( history );
+}
@@ -0,0 +1,31 @@
+#include "Backend/XorIndexing.hpp"
+
+#include <bit>
+
+XorIndexing::XorIndexing( discrete_t nsets ) : Indexing( nsets ) {
+    bits = ( bits_t ) std::countr_zero( nsets );
+}
+
+XorIndexing::~XorIndexing() {
+}
+
+discrete_t XorIndexing::Index( discrete_t block , [[maybe_unused]] discrete_t way ) const {
+    if ( bits == 0 ) {
+        return 0;
+    }
+    discrete_t index = 0;
+    for ( ; block != 0 ; block >>= bits ) {
+        index ^= block;
+    }
+    return index & ( nsets - 1 );
+}
+
+discrete_t XorIndexing::Tag( discrete_t block ) const {
+    return block >> bits;
+}
+
+// The index is the low bits folded with the tag, so folding the tag out again
+// gives the low bits back.
+discrete_t XorIndexing::Block( discrete_t index , discrete_t tag ) const {
+    return ( tag << bits ) | ( ( index ^ Index( tag , 0 ) ) & ( nsets - 1 ) );
+}
@@ -1356,6 +1356,12 @@ auto Simulator::drawConnection(Object &box, Object &indexBox,
            case AccessResult::CAPACITY_MISS:
              upperStr = "Capacity";
              break;
+           case AccessResult::SECTOR_MISS:
+             upperStr = "Sector";
+             break;
+           case AccessResult::COHERENCE_MISS:
+             upperStr = "Coherence";
+             break;
            case AccessResult::UNKOWN:
              break;
            }
@@ -1,28 +1,255 @@
 #include "app.hpp"
 
 #include "Backend/Cache.hpp"
+#include "Backend/EventQueue.hpp"
+#include "Backend/MultiCore.hpp"
+#include "Backend/TraceProfile.hpp"
 #include "Frontend/HeadLess.hpp"
 #ifdef BUILD_GUI
 #include "Frontend/Simulator/Simulator.hpp"
 #endif
+#include "common/Archive.hpp"
+#include "common/Options.hpp"
 #include "common/TQueue.hpp"
 
+#include <array>
+#include <bit>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <random>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
-static auto getBackend(std::span<std::string> args) -> std::unique_ptr<Backend>;
+static auto getBackend(std::span<std::string> args, const Options &options)
+    -> std::unique_ptr<Backend>;
 static auto getFrontend(std::string &id, std::unique_ptr<Backend> &backend)
     -> std::unique_ptr<Frontend>;
 static auto flipWord(addr_t *word) -> void;
 
+// Checkpoints start with this and their format version, then the arguments
+// they were taken with, how many accesses they hold and how long the output
+// files were.
+static constexpr std::array<char, 8> CHECKPOINT_MAGIC = {'C', 'S', 'I', 'M',
+                                                         'C', 'K', 'P', 'T'};
+static constexpr uint32_t CHECKPOINT_VERSION = 2;
+
+// One trace file: its addresses, what the text lines say about them and when
+// they were made (the line number unless a `@time` is given).
+struct Trace {
+  std::vector<addr_t> addrs;
+  std::vector<TraceEntry> entries;
+  std::vector<discrete_t> times;
+  bool annotated = false;
+};
+
+static auto tracePaths(const std::string &path)
+    -> std::pair<std::filesystem::path, std::filesystem::path>;
+static auto loadTrace(const std::string &path) -> Trace;
+static auto writeCheckpoint(Backend *backend, const std::string &path,
+                            std::string signature, discrete_t position,
+                            std::vector<discrete_t> lengths) -> bool;
+static auto openOutput(const std::string &path, bool resuming,
+                       discrete_t length) -> std::unique_ptr<std::ofstream>;
+static auto interleave(std::vector<Trace> &traces, const Options &options)
+    -> Trace;
+
 App::App(std::unique_ptr<Backend> &&backend,
-         std::unique_ptr<Frontend> &&frontend, std::string &path)
-    : frontend(std::move(frontend)), backend(std::move(backend)),
-      running(true) {
+         std::unique_ptr<Frontend> &&frontend, std::string &path,
+         const Options &options, std::string signature)
+    : frontend(std::move(frontend)), backend(std::move(backend)), path(path),
+      options(options), signature(std::move(signature)), running(true) {
+  // Characterizing streams the trace itself.
+  if (options.has("characterize")) {
+    return;
+  }
 
-  addr_t addr = 0;
+  std::vector<Trace> traces;
+  traces.push_back(loadTrace(path));
+  // Further programs sharing the cache, as a comma separated list.
+  std::istringstream programs{options.get("programs", "")};
+  std::string program;
+  while (std::getline(programs, program, ',')) {
+    if (program.empty()) {
+      continue;
+    }
+    if (!std::filesystem::exists(tracePaths(program).first)) {
+      std::cout << "No trace " << program
+                << " for --programs\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    traces.push_back(loadTrace(program));
+  }
+
+  Trace trace =
+      traces.size() == 1 ? std::move(traces[0]) : interleave(traces, options);
+  for (addr_t addr : trace.addrs) {
+    addrs.push(addr);
+  }
+  if (options.has("simpoints")) {
+    phases = std::make_unique<SimPoint>(
+        options.get("interval", 100000),
+        (bits_t)std::min<discrete_t>(options.get("simpoint-region", 12), 32),
+        options.get("simpoint-dims", 15));
+    for (addr_t addr : trace.addrs) {
+      phases->Access(addr);
+    }
+    phases->Finish();
+  }
+  if (trace.annotated) {
+    this->backend->setTrace(std::move(trace.entries));
+  }
+  total = addrs.size();
+
+  if (options.has("resume")) {
+    std::ifstream in{options.get("resume", ""), std::ios::binary};
+    Archive archive{in};
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    archive(magic)(version);
+    if (!in || magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION) {
+      std::cout << "Not a checkpoint of this simulator\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    std::string saved;
+    discrete_t position = 0;
+    archive(saved)(position)(lengths);
+    if (saved != this->signature) {
+      std::cout << "The checkpoint was taken with other arguments: " << saved
+                << "\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    this->backend->serialize(archive);
+    if (!in) {
+      std::cout << "The checkpoint is truncated\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    for (discrete_t i = 0; i < position && !addrs.empty(); i++) {
+      addrs.pop();
+    }
+  }
+
+  if (options.has("intervals")) {
+    bool resuming = options.has("resume");
+    intervals = openOutput(options.get("intervals", ""), resuming,
+                           lengths.empty() ? 0 : lengths[0]);
+    if (!resuming) {
+      *intervals << "end,accesses,hits,compulsory,capacity,conflict,sector,"
+                    "coherence,evictions,fetched,written_back,cycles\n";
+    }
+    last = this->backend->report();
+  }
+  if (options.has("heatmap")) {
+    bool resuming = options.has("resume");
+    heatmap = openOutput(options.get("heatmap", ""), resuming,
+                         lengths.size() < 2 ? 0 : lengths[1]);
+    if (!resuming) {
+      *heatmap << "end,kind,start,accesses,hits,compulsory,capacity,conflict,"
+                  "sector,coherence,evictions\n";
+    }
+  }
+}
+
+// Opens an output file; a resumed run cuts off what was written after its
+// checkpoint, then appends.
+static auto openOutput(const std::string &path, bool resuming,
+                       discrete_t length) -> std::unique_ptr<std::ofstream> {
+  if (resuming) {
+    std::error_code error;
+    std::filesystem::resize_file(path, length, error);
+  }
+  return std::make_unique<std::ofstream>(
+      path, resuming ? std::ios::app : std::ios::trunc);
+}
+
+// Writes next to `path` and renames, so an interrupted write leaves the last
+// checkpoint intact. Tells whether the checkpoint made it to `path`.
+static auto writeCheckpoint(Backend *backend, const std::string &path,
+                            std::string signature, discrete_t position,
+                            std::vector<discrete_t> lengths) -> bool {
+  std::string partial = path + ".part";
+  {
+    std::ofstream out{partial, std::ios::binary};
+    Archive archive{out};
+    std::array<char, 8> magic = CHECKPOINT_MAGIC;
+    uint32_t version = CHECKPOINT_VERSION;
+    archive(magic)(version)(signature)(position)(lengths);
+    backend->serialize(archive);
+    out.close();
+    if (!out) {
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(partial, path, error);
+  return !error;
+}
+
+static auto checkpointFailed(const std::string &path) -> void {
+  std::cout << "Could not write the checkpoint " << path
+            << "\n\tHALTING PROGRAM\n";
+  exit(EXIT_FAILURE);
+}
+
+// Waits for the process writing the last checkpoint and halts if it failed.
+auto App::awaitWriter() -> void {
+#if defined(__unix__) || defined(__APPLE__)
+  if (writer <= 0) {
+    return;
+  }
+  int status = 0;
+  waitpid(writer, &status, 0);
+  writer = 0;
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    checkpointFailed(options.get("checkpoint", ""));
+  }
+#endif
+}
+
+// Snapshots the state after `position` accesses. Where fork exists a child
+// writes its copy-on-write image of the simulator while the parent carries
+// on, so a checkpoint only stops the simulation for the fork.
+auto App::checkpoint(discrete_t position) -> void {
+  std::string path = options.get("checkpoint", "");
+  std::vector<discrete_t> lengths{
+      intervals ? (discrete_t)intervals->tellp() : 0,
+      heatmap ? (discrete_t)heatmap->tellp() : 0};
+#if defined(__unix__) || defined(__APPLE__)
+  awaitWriter();
+  // Worker threads do not survive fork, the child could not run a quantum.
+  backend->drain();
+  std::cout.flush();
+  if (intervals) {
+    intervals->flush();
+  }
+  if (heatmap) {
+    heatmap->flush();
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    _exit(writeCheckpoint(backend.get(), path, signature, position, lengths)
+              ? 0
+              : 1);
+  }
+  if (pid > 0) {
+    writer = pid;
+    return;
+  }
+#endif
+  if (!writeCheckpoint(backend.get(), path, signature, position, lengths)) {
+    checkpointFailed(path);
+  }
+}
 
+// The binary and text files of a trace.
+static auto tracePaths(const std::string &path)
+    -> std::pair<std::filesystem::path, std::filesystem::path> {
   std::filesystem::path root = std::filesystem::current_path();
   std::filesystem::path l = root / path;
   std::filesystem::path txt = root / path;
@@ -32,47 +259,837 @@ App::App(std::unique_ptr<Backend> &&backend,
     l = root / path;
     txt = root / (path.substr(0, path.length() - 3) + "txt");
   }
+  return {l, txt};
+}
 
-  
+static auto loadTrace(const std::string &path) -> Trace {
+  addr_t addr = 0;
+
+  auto [l, txt] = tracePaths(path);
   std::ifstream in{l.string(), std::ios::binary};
   std::ifstream inTxt{txt.string()};
 
+  // A text line may follow the address with `r` or `w`, the id of the core
+  // that made the access and `@time`.
+  Trace trace;
   while (in.read((char *)&addr, sizeof(addr))) {
     std::string gabas;
     std::getline(inTxt, gabas);
 
-    addr_t gab = (addr_t) std::stoull(gabas);
+    size_t end = 0;
+    addr_t gab = (addr_t) std::stoull(gabas, &end);
     if(addr != gab){
       flipWord(&addr);
     }
-    addrs.push(addr);
+    trace.addrs.push_back(addr);
+
+    TraceEntry entry;
+    discrete_t time = trace.times.size();
+    std::istringstream rest{gabas.substr(end)};
+    std::string token;
+    while (rest >> token) {
+      if (token == "w" || token == "W") {
+        entry.type = AccessType::WRITE;
+      } else if (token == "r" || token == "R") {
+        entry.type = AccessType::READ;
+      } else if (token[0] == '@' && token.size() > 1) {
+        time = std::stoull(token.substr(1));
+        trace.annotated = true;
+      } else if (std::isdigit((unsigned char)token[0])) {
+        entry.core = (uint16_t)std::stoul(token);
+      }
+    }
+    entry.time = time;
+    trace.entries.push_back(entry);
+    trace.times.push_back(time);
+    trace.annotated |= entry.type == AccessType::WRITE || entry.core != 0;
+  }
+  return trace;
+}
+
+// Appends the accesses of `trace` to `merged` at their times.
+static auto replay(EventQueue &events, const Trace &trace, uint16_t program,
+                   Trace &merged) -> Process {
+  for (size_t i = 0; i < trace.addrs.size(); i++) {
+    co_await events.At(trace.times[i]);
+    TraceEntry entry = trace.entries[i];
+    entry.program = program;
+    merged.addrs.push_back(trace.addrs[i]);
+    merged.entries.push_back(entry);
+  }
+}
+
+// Merges the traces of several programs into one stream, tagging every entry
+// with its program: `rr` takes one access of each in turn, `weighted` follows
+// --weights with smooth weighted round robin, and `time` orders by timestamp.
+static auto interleave(std::vector<Trace> &traces, const Options &options)
+    -> Trace {
+  std::string policy = options.get("interleave", "rr");
+  if (policy != "rr" && policy != "weighted" && policy != "time") {
+    std::cout << "--interleave is rr, weighted or time\n\tHALTING PROGRAM\n";
+    exit(0);
+  }
+  std::vector<discrete_t> weights(traces.size(), 1);
+  std::istringstream list{options.get("weights", "")};
+  std::string weight;
+  for (size_t i = 0; i < traces.size() && std::getline(list, weight, ',');
+       i++) {
+    char *end = nullptr;
+    discrete_t value = std::strtoull(weight.c_str(), &end, 10);
+    if (weight.empty() || !std::isdigit((unsigned char)weight[0]) ||
+        *end != '\0') {
+      std::cout << "Not a weight: " << weight << "\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    weights[i] = std::max<discrete_t>(value, 1);
+  }
+
+  Trace merged;
+  merged.annotated = true;
+  std::vector<size_t> next(traces.size(), 0);
+  std::vector<int64_t> credit(traces.size(), 0);
+  size_t left = 0;
+  for (Trace &trace : traces) {
+    left += trace.addrs.size();
+  }
+  merged.addrs.reserve(left);
+  merged.entries.reserve(left);
+  if (policy == "time") {
+    // Every program is a process sleeping until its next access is due.
+    EventQueue events;
+    for (size_t i = 0; i < traces.size(); i++) {
+      replay(events, traces[i], (uint16_t)i, merged);
+    }
+    events.Run();
+    return merged;
   }
+  size_t turn = 0;
+  while (left > 0) {
+    size_t pick = traces.size();
+    if (policy == "weighted") {
+      // Every live program gains its weight, the richest one runs and pays
+      // the total back.
+      int64_t total = 0;
+      for (size_t i = 0; i < traces.size(); i++) {
+        if (next[i] < traces[i].addrs.size()) {
+          credit[i] += (int64_t)weights[i];
+          total += (int64_t)weights[i];
+          if (pick == traces.size() || credit[i] > credit[pick]) {
+            pick = i;
+          }
+        }
+      }
+      credit[pick] -= total;
+    } else {
+      while (next[turn] == traces[turn].addrs.size()) {
+        turn = (turn + 1) % traces.size();
+      }
+      pick = turn;
+      turn = (turn + 1) % traces.size();
+    }
+    TraceEntry entry = traces[pick].entries[next[pick]];
+    entry.program = (uint16_t)pick;
+    merged.addrs.push_back(traces[pick].addrs[next[pick]]);
+    merged.entries.push_back(entry);
+    next[pick]++;
+    left--;
+  }
+  return merged;
 }
 
 auto App::run() -> void {
-  while (!frontend->halted() && !addrs.empty()) {
+  if (options.has("characterize")) {
+    characterize();
+    return;
+  }
+  if (phases) {
+    simpoints();
+    return;
+  }
+  // Variant names are checked before the warm-up is spent on them.
+  std::vector<std::string> names;
+  std::istringstream list{options.get("variants", "")};
+  std::string name;
+  while (std::getline(list, name, ',')) {
+    if (name.empty()) {
+      continue;
+    }
+    if (name != "R" && backend->getCache().SetREPL(name) == REPL::RANDOM) {
+      std::cout << "Unknown replacement policy " << name
+                << " in --variants\n\tHALTING PROGRAM\n";
+      exit(0);
+    }
+    names.push_back(name);
+  }
+  // Counters restored from a checkpoint past the warm-up are kept.
+  discrete_t warmup = options.get("warmup", 0);
+  if (warmup > total - addrs.size()) {
+    simulate(warmup);
+    backend->resetReport();
+    last = CacheReport();
+  }
+  if (options.has("variants")) {
+    variants(names);
+    return;
+  }
+  simulate(total);
+  awaitWriter();
+  if (heatmap && !intervals) {
+    backend->drain();
+    dumpHeatmap(total - addrs.size());
+  }
+  print(std::cout);
+}
+
+// Runs the trace until `until` accesses have been made or it ends.
+auto App::simulate(discrete_t until) -> void {
+  bool checkpointing = options.has("checkpoint");
+  discrete_t every =
+      std::max<discrete_t>(options.get("checkpoint-every", 1000000), 1);
+  discrete_t next = (total - addrs.size()) / every * every + every;
+  discrete_t period = std::max<discrete_t>(options.get("interval", 100000), 1);
+  discrete_t sampled = (total - addrs.size()) / period * period + period;
+  // Samples and checkpoints wait for the accesses in flight, so reading the
+  // counters never ends a quantum early.
+  while (!frontend->halted() && !addrs.empty() &&
+         total - addrs.size() < until) {
     frontend->tick(backend.get(), addrs);
+    discrete_t position = total - addrs.size();
+    if (intervals && position >= sampled && backend->settled()) {
+      sample(position);
+      sampled = position / period * period + period;
+    }
+    if (checkpointing && position >= next && backend->settled()) {
+      checkpoint(position);
+      next = position / every * every + every;
+    }
+  }
+  if (addrs.empty()) {
+    backend->finish();
+  }
+  if (intervals && addrs.empty()) {
+    sample(total);
+  }
+}
+
+// Writes what changed since the last sample as one row of the time series.
+auto App::sample(discrete_t position) -> void {
+  CacheReport now = backend->report();
+  if (now.accesses == last.accesses) {
+    return;
+  }
+  *intervals << position << ',' << now.accesses - last.accesses << ','
+             << now.hits - last.hits << ','
+             << now.compulsory_miss - last.compulsory_miss << ','
+             << now.capacity_miss - last.capacity_miss << ','
+             << now.conflict_miss - last.conflict_miss << ','
+             << now.sector_misses - last.sector_misses << ','
+             << now.coherence_misses - last.coherence_misses << ','
+             << now.evictions - last.evictions << ','
+             << now.bytes_fetched - last.bytes_fetched << ','
+             << now.bytes_written_back - last.bytes_written_back << ','
+             << now.total_cycles - last.total_cycles << '\n';
+  last = now;
+  if (heatmap) {
+    dumpHeatmap(position);
+  }
+}
+
+// Writes the sets and regions touched since the last dump, all cores merged,
+// and starts their counters over. Only called once the backend has settled.
+auto App::dumpHeatmap(discrete_t position) -> void {
+  std::vector<Heatmap *> maps;
+  if (auto *cache = dynamic_cast<Cache *>(backend.get())) {
+    maps.push_back(cache->Heat());
+  } else if (auto *multi = dynamic_cast<MultiCore *>(backend.get())) {
+    for (discrete_t core = 0; core < multi->Cores(); core++) {
+      maps.push_back(multi->Core(core).Heat());
+    }
+  }
+  if (maps.empty()) {
+    return;
+  }
+  Heatmap merged = *maps[0];
+  for (size_t i = 1; i < maps.size(); i++) {
+    merged.Merge(*maps[i]);
   }
+  auto row = [&](const char *kind, discrete_t start,
+                 const Heatmap::Counters &counters) {
+    if (counters.accesses == 0 && counters.evictions == 0) {
+      return;
+    }
+    *heatmap << position << ',' << kind << ',' << start << ','
+             << counters.accesses << ',' << counters.hits << ','
+             << counters.compulsory << ',' << counters.capacity << ','
+             << counters.conflict << ',' << counters.sector << ','
+             << counters.coherence << ',' << counters.evictions << '\n';
+  };
+  const std::vector<Heatmap::Counters> &sets = merged.Sets();
+  for (size_t set = 0; set < sets.size(); set++) {
+    row("set", set, sets[set]);
+  }
+  for (const auto &[start, counters] : merged.Regions()) {
+    row("region", start, counters);
+  }
+  for (Heatmap *map : maps) {
+    map->Clear();
+  }
+}
+
+// Runs the rest of the trace once per policy of --variants, each from its own
+// copy of the warmed state. Where fork exists the copies are copy-on-write
+// images simulated side by side; otherwise the state is saved once and
+// restored before each variant.
+auto App::variants(const std::vector<std::string> &names) -> void {
+  backend->drain();
+  std::vector<std::string> outputs(names.size());
+  std::vector<bool> failed(names.size(), false);
+  // Variants only run the suffix, their state is not checkpointed and the
+  // time series and heatmap end with the warm-up.
+  options.erase("checkpoint");
+  if (intervals) {
+    intervals->flush();
+    intervals.reset();
+  }
+  if (heatmap) {
+    dumpHeatmap(total - addrs.size());
+    heatmap->flush();
+    heatmap.reset();
+  }
+  awaitWriter();
+#if defined(__unix__) || defined(__APPLE__)
+  // Worker threads do not survive a fork.
+  if (options.get("threads", 1) <= 1) {
+    std::cout.flush();
+    std::vector<std::pair<pid_t, int>> children;
+    for (const std::string &variant : names) {
+      int fds[2];
+      if (pipe(fds) != 0) {
+        break;
+      }
+      pid_t pid = fork();
+      if (pid == 0) {
+        close(fds[0]);
+        // A variant that halts exits through exit() with its message on
+        // stdout; send the message down the pipe and mark the child failed.
+        dup2(fds[1], STDOUT_FILENO);
+        std::atexit(+[] {
+          std::cout.flush();
+          _exit(EXIT_FAILURE);
+        });
+        std::string output = runVariant(variant);
+        for (size_t done = 0; done < output.size();) {
+          ssize_t written =
+              write(fds[1], output.data() + done, output.size() - done);
+          if (written <= 0) {
+            break;
+          }
+          done += (size_t)written;
+        }
+        _exit(0);
+      }
+      close(fds[1]);
+      if (pid < 0) {
+        close(fds[0]);
+        break;
+      }
+      children.emplace_back(pid, fds[0]);
+    }
+    for (size_t i = 0; i < children.size(); i++) {
+      char buffer[4096];
+      ssize_t got;
+      while ((got = read(children[i].second, buffer, sizeof(buffer))) > 0) {
+        outputs[i].append(buffer, (size_t)got);
+      }
+      close(children[i].second);
+      int status = 0;
+      waitpid(children[i].first, &status, 0);
+      failed[i] = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    if (children.size() == names.size()) {
+      printVariants(names, outputs, failed);
+      return;
+    }
+  }
+#endif
+  std::stringstream snapshot;
+  Archive save{static_cast<std::ostream &>(snapshot)};
+  backend->serialize(save);
+  std::queue<addr_t> rest = addrs;
+  REPL warmed = backend->getCache().substitutionPolitics;
+  for (size_t i = 0; i < names.size(); i++) {
+    if (!outputs[i].empty()) {
+      continue;
+    }
+    snapshot.clear();
+    snapshot.seekg(0);
+    backend->setPolicy(warmed, options);
+    Archive load{static_cast<std::istream &>(snapshot)};
+    backend->serialize(load);
+    addrs = rest;
+    outputs[i] = runVariant(names[i]);
+  }
+  printVariants(names, outputs, failed);
+}
+
+// The warmed policy keeps its state, others start from the warmed lines.
+auto App::runVariant(const std::string &name) -> std::string {
+  REPL repl = backend->getCache().SetREPL(name);
+  if (repl != backend->getCache().substitutionPolitics) {
+    backend->setPolicy(repl, options);
+  }
+  simulate(total);
+  std::ostringstream out;
+  print(out);
+  return out.str();
+}
+
+// Exits with a failure status when a variant did not finish.
+auto App::printVariants(const std::vector<std::string> &names,
+                        const std::vector<std::string> &outputs,
+                        const std::vector<bool> &failed) -> void {
+  for (size_t i = 0; i < names.size(); i++) {
+    std::istringstream lines{outputs[i]};
+    std::string line;
+    while (std::getline(lines, line)) {
+      std::cout << "variant " << names[i] << " " << line << "\n";
+    }
+    if (failed[i]) {
+      std::cout << "variant " << names[i] << " failed\n";
+    }
+  }
+  if (std::find(failed.begin(), failed.end(), true) != failed.end()) {
+    std::cout.flush();
+    exit(EXIT_FAILURE);
+  }
+}
+
+// Reads the binary trace in blocks and feeds every address to a fixed-size
+// profile, so memory does not grow with the trace. The byte order is told once
+// by the first text line instead of for every address.
+auto App::characterize() -> void {
+  auto [l, txt] = tracePaths(path);
+  std::ifstream in{l.string(), std::ios::binary};
+  std::ifstream inTxt{txt.string()};
+  TraceProfile profile{
+      backend->getCache().bits.offset,
+      (bits_t)std::clamp<discrete_t>(options.get("hll-bits", 14), 4, 18),
+      options.get("hot-counters", 1024)};
+  discrete_t window = std::max<discrete_t>(options.get("interval", 100000), 1);
+
+  discrete_t next = window;
+
+  std::vector<addr_t> chunk(1 << 16);
+  // The byte order is told by the first text line whose value reads
+  // differently swapped; the addresses before it read the same either way.
+  bool flip = false;
+  bool decided = false;
+  while (in.read((char *)chunk.data(),
+                 (std::streamsize)(chunk.size() * sizeof(addr_t))) ||
+         in.gcount() > 0) {
+    size_t read = (size_t)in.gcount() / sizeof(addr_t);
+    for (size_t i = 0; i < read; i++) {
+      std::string line;
+      if (!decided && std::getline(inTxt, line) && !line.empty()) {
+        addr_t value = (addr_t)std::stoull(line);
+        addr_t swapped = value;
+        flipWord(&swapped);
+        if (value != swapped) {
+          flip = chunk[i] != value;
+          decided = true;
+        }
+      } else if (!decided) {
+        decided = true;
+      }
+      if (flip) {
+        flipWord(&chunk[i]);
+      }
+      profile.Access(chunk[i]);
+      if (profile.Accesses() == next) {
+        std::cout << "window " << next << " " << profile.EndWindow() << "\n";
+        next += window;
+      }
+    }
+  }
+  if (profile.Accesses() + window != next) {
+    std::cout << "window " << profile.Accesses() << " " << profile.EndWindow()
+              << "\n";
+  }
+
+  discrete_t blocks = profile.Footprint();
+  std::cout << "footprint " << profile.Accesses() << " " << blocks << " "
+            << blocks * backend->getCache().block << "\n";
+  for (discrete_t bucket = TraceProfile::BUCKETS; bucket-- > 1;) {
+    if (profile.Backward()[bucket] > 0) {
+      std::cout << "stride -" << TraceProfile::From(bucket) << " "
+                << profile.Backward()[bucket] << "\n";
+    }
+  }
+  for (discrete_t bucket = 0; bucket < TraceProfile::BUCKETS; bucket++) {
+    if (profile.Forward()[bucket] > 0) {
+      std::cout << "stride " << TraceProfile::From(bucket) << " "
+                << profile.Forward()[bucket] << "\n";
+    }
+  }
+  for (const SpaceSaving::Counter &counter :
+       profile.Hottest(options.get("hot", 10))) {
+    std::cout << "hot " << (counter.key << backend->getCache().bits.offset)
+              << " " << counter.count << " " << counter.error << "\n";
+  }
+}
+
+// Moves past the accesses before `until` without simulating them.
+auto App::skip(discrete_t until) -> void {
+  size_t count = 0;
+  while (!addrs.empty() && total - addrs.size() < until) {
+    addrs.pop();
+    count++;
+  }
+  backend->skip(count);
+}
+
+// Counters of the timing model, which resetReport() leaves running.
+static constexpr std::array<discrete_t CacheReport::*, 13> TIMED = {
+    &CacheReport::total_cycles,        &CacheReport::latency_cycles,
+    &CacheReport::merged_misses,       &CacheReport::mshr_stall_cycles,
+    &CacheReport::bank_stall_cycles,   &CacheReport::mshr_busy_cycles,
+    &CacheReport::dram_requests,       &CacheReport::dram_row_hits,
+    &CacheReport::dram_row_misses,     &CacheReport::dram_row_conflicts,
+    &CacheReport::dram_bytes,          &CacheReport::dram_latency_cycles,
+    &CacheReport::dram_cycles};
+
+// Counters scaled from the simulated intervals to the whole trace. Hits are
+// what the misses leave, so that the two add up.
+static constexpr std::array<discrete_t CacheReport::*, 23> ESTIMATED = {
+    &CacheReport::accesses,           &CacheReport::miss,
+    &CacheReport::compulsory_miss,    &CacheReport::conflict_miss,
+    &CacheReport::capacity_miss,      &CacheReport::sector_misses,
+    &CacheReport::coherence_misses,   &CacheReport::bytes_fetched,
+    &CacheReport::bytes_written_back, &CacheReport::evictions,
+    &CacheReport::total_cycles,       &CacheReport::latency_cycles,
+    &CacheReport::merged_misses,      &CacheReport::mshr_stall_cycles,
+    &CacheReport::bank_stall_cycles,  &CacheReport::mshr_busy_cycles,
+    &CacheReport::dram_requests,      &CacheReport::dram_row_hits,
+    &CacheReport::dram_row_misses,    &CacheReport::dram_row_conflicts,
+    &CacheReport::dram_bytes,         &CacheReport::dram_latency_cycles,
+    &CacheReport::dram_cycles};
+
+// The timing model's lines of the output.
+static auto printTiming(std::ostream &out, const CacheReport &results,
+                        const Options &options) -> void {
+  out << "timing " << results.amat << " " << results.total_cycles << "\n";
+  if (options.has("mshrs")) {
+    out << "nonblocking " << results.merged_misses << " "
+        << results.mshr_stall_cycles << " " << results.bank_stall_cycles
+        << " " << results.mshr_occupancy << "\n";
+  }
+  if (options.has("dram")) {
+    out << "dram " << results.dram_row_hit_rate << " " << results.dram_latency
+        << " " << results.dram_bandwidth << " " << results.dram_row_hits
+        << " " << results.dram_row_misses << " " << results.dram_row_conflicts
+        << " " << results.dram_requests << "\n";
+  }
+}
+
+// Simulates the representative of every phase plus up to --simpoint-extra
+// other intervals drawn from it, each after --simpoint-warmup accesses that
+// only warm the cache; the trace in between is skipped and the cache keeps
+// whatever it held. A phase's counters are those of its samples scaled to
+// all its accesses. The error is the standard error of the miss rate over
+// the phases sampled more than once.
+auto App::simpoints() -> void {
+  if (options.has("warmup") || options.has("variants") ||
+      options.has("intervals") || options.has("checkpoint") ||
+      options.has("resume")) {
+    std::cout << "--simpoints picks its own warm-ups and runs on its "
+                 "own\n\tHALTING PROGRAM\n";
+    exit(0);
+  }
+  std::vector<SimPoint::Phase> found =
+      phases->Cluster(options.get("simpoints", 10), options.get("seed", 1));
+
+  struct Sample {
+    discrete_t interval;
+    size_t phase;
+    CacheReport report;
+  };
+  std::mt19937_64 random{options.get("seed", 1)};
+  discrete_t extra = options.get("simpoint-extra", 1);
+  std::vector<Sample> samples;
+  for (size_t p = 0; p < found.size(); p++) {
+    samples.push_back({found[p].representative, p, {}});
+    std::vector<discrete_t> others;
+    std::copy_if(found[p].members.begin(), found[p].members.end(),
+                 std::back_inserter(others), [&](discrete_t interval) {
+                   return interval != found[p].representative;
+                 });
+    std::shuffle(others.begin(), others.end(), random);
+    for (size_t i = 0; i < std::min<size_t>(extra, others.size()); i++) {
+      samples.push_back({others[i], p, {}});
+    }
+  }
+  std::sort(samples.begin(), samples.end(),
+            [](const Sample &a, const Sample &b) {
+              return a.interval < b.interval;
+            });
+
+  discrete_t warmup = options.get("simpoint-warmup", phases->Length());
+  discrete_t simulated = 0;
+  for (Sample &sample : samples) {
+    discrete_t start = sample.interval * phases->Length();
+    discrete_t from = start > warmup ? start - warmup : 0;
+    if (from > total - addrs.size()) {
+      skip(from);
+    }
+    simulated += start - (total - addrs.size());
+    simulate(start);
+    backend->finish();
+    backend->resetReport();
+    CacheReport before = backend->report();
+    simulate(start + phases->Size(sample.interval));
+    backend->finish();
+    sample.report = backend->report();
+    for (discrete_t CacheReport::*field : TIMED) {
+      sample.report.*field -= before.*field;
+    }
+    sample.report.Calculate();
+    simulated += sample.report.accesses;
+  }
+
+  CacheReport estimate;
+  double variance = 0.0;
+  for (size_t p = 0; p < found.size(); p++) {
+    CacheReport sampled;
+    std::vector<double> rates;
+    for (const Sample &sample : samples) {
+      if (sample.phase == p) {
+        // Summed, where Accumulate() takes the slowest core's cycles.
+        for (discrete_t CacheReport::*field : ESTIMATED) {
+          sampled.*field += sample.report.*field;
+        }
+        rates.push_back(sample.report.miss_rate);
+      }
+    }
+    double scale = (double)found[p].accesses / (double)sampled.accesses;
+    for (discrete_t CacheReport::*field : ESTIMATED) {
+      estimate.*field +=
+          (discrete_t)std::llround((double)(sampled.*field) * scale);
+    }
+    // Stratified sampling without replacement from the phase's intervals.
+    double n = (double)rates.size();
+    double members = (double)found[p].members.size();
+    if (rates.size() > 1) {
+      double mean = 0.0;
+      for (double rate : rates) {
+        mean += rate / n;
+      }
+      double spread = 0.0;
+      for (double rate : rates) {
+        spread += (rate - mean) * (rate - mean) / (n - 1.0);
+      }
+      double weight = (double)found[p].accesses / (double)total;
+      variance += weight * weight * spread / n * (1.0 - n / members);
+    }
+  }
+  estimate.hits = estimate.accesses - estimate.miss;
+  estimate.Calculate();
+
+  for (const Sample &sample : samples) {
+    std::cout << "simpoint " << sample.interval * phases->Length() << " "
+              << sample.phase << " "
+              << (double)found[sample.phase].accesses / (double)total /
+                     (double)std::count_if(samples.begin(), samples.end(),
+                                           [&](const Sample &other) {
+                                             return other.phase ==
+                                                    sample.phase;
+                                           })
+              << " " << sample.report.miss_rate << "\n";
+  }
+  std::cout << "phases " << phases->Intervals() << " " << found.size() << " "
+            << simulated << " " << total << "\n";
+  // The miss classes are left out: skipping the trace between the samples
+  // turns capacity and conflict misses into compulsory ones.
+  std::cout << "estimate " << estimate.accesses << " " << estimate.hit_rate
+            << " " << estimate.miss_rate << " " << std::sqrt(variance) << "\n";
+  if (options.has("timing") || options.has("dram")) {
+    printTiming(std::cout, estimate, options);
+  }
+}
+
+auto App::print(std::ostream &out) -> void {
   CacheReport results = backend.get()->report();
-  std::cout << results.accesses << " " << results.hit_rate << " "
-            << results.miss_rate << " " << results.compulsory_miss_rate << " "
-            << results.capacity_miss_rate << " " << results.conflict_miss_rate
-            << "\n";
+  out << results.accesses << " " << results.hit_rate << " " << results.miss_rate
+      << " " << results.compulsory_miss_rate << " "
+      << results.capacity_miss_rate << " " << results.conflict_miss_rate
+      << "\n";
+  if (results.predictions > 0) {
+    out << "ship " << results.bypasses << " " << results.prediction_accuracy
+        << "\n";
+  }
+  if (options.has("sectors")) {
+    out << "sectors " << results.tag_misses << " " << results.sector_misses
+        << " " << results.bytes_fetched << " " << results.bytes_written_back
+        << "\n";
+  }
+  if (options.has("tlb")) {
+    out << "tlb " << results.tlb_l1_hits << " " << results.tlb_l2_hits << " "
+        << results.page_walks << " " << results.walk_cycles << "\n";
+  }
+  if (options.has("timing") || options.has("dram")) {
+    printTiming(out, results, options);
+    Timing latencies{options};
+    if (auto *cache = dynamic_cast<Cache *>(backend.get())) {
+      latencies.Merge(*cache->Latencies());
+    } else if (auto *multi = dynamic_cast<MultiCore *>(backend.get())) {
+      for (discrete_t core = 0; core < multi->Cores(); core++) {
+        latencies.Merge(*multi->Core(core).Latencies());
+      }
+    }
+    for (AccessType type : {AccessType::READ, AccessType::WRITE}) {
+      const Timing::Histogram &histogram = latencies.Latencies(type);
+      for (discrete_t bucket = 0; bucket < Timing::BUCKETS; bucket++) {
+        if (histogram[bucket] > 0) {
+          out << "latency " << (type == AccessType::READ ? "read " : "write ")
+              << ((discrete_t)1 << bucket) << " " << histogram[bucket] << "\n";
+        }
+      }
+    }
+  }
+  if (options.has("lifetimes")) {
+    out << "lifetime " << results.lifetime_evictions << " "
+        << results.never_hit_rate << " " << results.dead_fraction << " "
+        << results.live_time << " " << results.dead_time << "\n";
+    Lifetimes lives{0};
+    if (auto *cache = dynamic_cast<Cache *>(backend.get())) {
+      lives.Merge(*cache->Lives());
+    } else if (auto *multi = dynamic_cast<MultiCore *>(backend.get())) {
+      for (discrete_t core = 0; core < multi->Cores(); core++) {
+        lives.Merge(*multi->Core(core).Lives());
+      }
+    }
+    for (auto [kind, histogram] :
+         {std::pair{"live", &lives.Live()}, std::pair{"dead", &lives.Dead()},
+          std::pair{"reuse", &lives.Hits()}}) {
+      for (discrete_t bucket = 0; bucket < Lifetimes::BUCKETS; bucket++) {
+        if ((*histogram)[bucket] > 0) {
+          out << kind << " " << Lifetimes::From(bucket) << " "
+              << (*histogram)[bucket] << "\n";
+        }
+      }
+    }
+  }
+  // Every core keeps its own counters and partition, the program counters are
+  // summed over them.
+  std::vector<Cache *> caches;
+  if (auto *cache = dynamic_cast<Cache *>(backend.get())) {
+    caches.push_back(cache);
+  } else if (auto *multi = dynamic_cast<MultiCore *>(backend.get())) {
+    for (discrete_t core = 0; core < multi->Cores(); core++) {
+      caches.push_back(&multi->Core(core));
+    }
+  }
+  if (options.has("programs")) {
+    std::vector<Cache::ProgramReport> programs;
+    for (Cache *cache : caches) {
+      const std::vector<Cache::ProgramReport> &own = cache->Programs();
+      if (programs.size() < own.size()) {
+        programs.resize(own.size());
+      }
+      for (size_t i = 0; i < own.size(); i++) {
+        programs[i].accesses += own[i].accesses;
+        programs[i].miss += own[i].miss;
+        programs[i].interference += own[i].interference;
+        programs[i].occupancy += own[i].occupancy;
+      }
+    }
+    for (size_t i = 0; i < programs.size(); i++) {
+      // A program that made no access has no miss rate, print 0.
+      percentage_t missRate = programs[i].accesses == 0
+                                  ? 0
+                                  : (percentage_t)programs[i].miss /
+                                        (percentage_t)programs[i].accesses;
+      out << "program " << i << " " << programs[i].accesses << " " << missRate
+          << " " << programs[i].interference << " " << programs[i].occupancy
+          << "\n";
+    }
+  }
+  for (size_t core = 0; core < caches.size(); core++) {
+    if (!caches[core]->Partition()) {
+      continue;
+    }
+    for (const WayPartition::Interval &interval :
+         caches[core]->Partition()->History()) {
+      for (size_t i = 0; i < interval.ways.size(); i++) {
+        // A program idle for the whole interval has no hit rate, print 0.
+        percentage_t hitRate = interval.accesses[i] == 0
+                                   ? 0
+                                   : (percentage_t)interval.hits[i] /
+                                         (percentage_t)interval.accesses[i];
+        out << "partition " << interval.end << " " << i << " "
+            << interval.ways[i] << " " << interval.accesses[i] << " "
+            << hitRate;
+        // Cores partition their caches on their own.
+        if (caches.size() > 1) {
+          out << " " << core;
+        }
+        out << "\n";
+      }
+    }
+  }
+  if (auto *multi = dynamic_cast<MultiCore *>(backend.get())) {
+    for (discrete_t core = 0; core < multi->Cores(); core++) {
+      CacheReport &own = multi->CoreReport(core);
+      // A core that made no access has no rates, print 0.
+      bool idle = own.accesses == 0;
+      out << "core " << core << " " << own.accesses << " "
+          << (idle ? 0 : own.hit_rate) << " " << (idle ? 0 : own.miss_rate)
+          << " " << own.coherence_misses << "\n";
+    }
+    out << "coherence " << results.coherence_misses << " "
+        << results.invalidations << " " << results.upgrades << " "
+        << results.interventions << "\n";
+    if (SharingProfiler *profiler = multi->Profiler()) {
+      out << "sharing " << results.true_sharing_misses << " "
+          << results.false_sharing_misses << "\n";
+      for (const SharingProfiler::Hotspot &hot : profiler->Ranked(
+               options.get("sharing-top", 10),
+               (bits_t)options.get("sharing-region", 0))) {
+        out << "hotspot " << hot.addr << " " << hot.invalidations << " "
+            << hot.trueSharing << " " << hot.falseSharing << " "
+            << std::popcount(hot.cores) << "\n";
+      }
+    }
+  }
 }
 
 auto App::generateApp(std::vector<std::string> &command) -> App {
   constexpr size_t SEP = 5;
 
+  Options options{
+      std::span(command).subspan(std::min(SEP + 2, command.size()))};
   std::unique_ptr<Backend> backend =
-      getBackend(std::span(std::next(command.begin()), SEP - 1));
+      getBackend(std::span(std::next(command.begin()), SEP - 1), options);
   std::unique_ptr<Frontend> frontend = getFrontend(command.at(SEP), backend);
 
-  return App(std::move(backend), std::move(frontend), command.at(SEP + 1));
+  // Everything but the checkpoint options must match to resume.
+  std::string signature;
+  for (size_t i = 1; i < command.size(); i++) {
+    if (command[i].rfind("--checkpoint", 0) != 0 &&
+        command[i].rfind("--resume", 0) != 0) {
+      signature += command[i] + " ";
+    }
+  }
+
+  return App(std::move(backend), std::move(frontend), command.at(SEP + 1),
+             options, std::move(signature));
 }
 
-static auto getBackend(std::span<std::string> args)
+static auto getBackend(std::span<std::string> args, const Options &options)
     -> std::unique_ptr<Backend> {
-  return std::make_unique<Cache>(args);
+  if (options.get("cores", 1) > 1) {
+    return std::make_unique<MultiCore>(args, options);
+  }
+  return std::make_unique<Cache>(args, options);
 }
 
 static auto getFrontend(std::string &id, std::unique_ptr<Backend> &backend)